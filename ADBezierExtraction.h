@@ -0,0 +1,113 @@
+// $Id$
+//==============================================================================
+//!
+//! \file ADBezierExtraction.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Element matrices from Bezier extraction and Bernstein tables.
+//!
+//==============================================================================
+
+#ifndef _AD_BEZIER_EXTRACTION_H
+#define _AD_BEZIER_EXTRACTION_H
+
+#include "MatVec.h"
+#include <vector>
+
+
+/*!
+  \brief Class computing constant-coefficient element matrices without
+  quadrature.
+  \details On each knot span, the B-splines are linear combinations of the
+  Bernstein polynomials, \f$N^e = C^e B\f$, with the extraction operator
+  \f$C^e\f$. The univariate element mass and stiffness matrices are then
+  \f$C^e M_B (C^e)^T\f$ and \f$C^e K_B (C^e)^T\f$, scaled by the element
+  size, where \f$M_B\f$ and \f$K_B\f$ are the exact Bernstein integral
+  tables on the unit interval. On a tensor-product patch with an
+  axis-parallel, affine geometry, the element matrices are sums of
+  Kronecker products of the univariate ones.
+
+  The univariate element matrices are computed once, such that each element
+  matrix costs only the Kronecker products, independent of the number of
+  quadrature points.
+
+  Knot spans with the same size and the same local knot pattern have the
+  same univariate matrices, which are stored only once. The elements then
+  fall into congruence classes, e.g., the interior elements of a uniform
+  mesh form a single class. When there are at least two elements per
+  class on average, the tensor-product matrices of each class are also
+  precomputed, and the element matrices are plain copies.
+*/
+
+class ADBezierExtraction
+{
+public:
+  //! \brief Default constructor.
+  ADBezierExtraction() {}
+
+  //! \brief Computes the univariate element matrices.
+  //! \param[in] knots Knot vector in each parameter direction
+  //! \param[in] order Spline order (degree + 1) in each direction
+  //! \param[in] length Physical length of the box in each direction
+  bool init(const std::vector<std::vector<double>>& knots,
+            const std::vector<int>& order,
+            const std::vector<double>& length);
+
+  //! \brief Returns \e true if the tables have not been computed.
+  bool empty() const { return dirs.empty(); }
+  //! \brief Returns the number of elements in the patch.
+  size_t getNoElms() const;
+  //! \brief Returns the number of congruence classes of the elements.
+  size_t getNoClasses() const;
+
+  //! \brief Adds the mass and stiffness matrices of an element.
+  //! \param[in] iel 0-based element index, with the first direction running
+  //! fastest over the non-zero knot spans
+  //! \param[in] sigma Mass coefficient
+  //! \param[in] kappa Diffusion coefficient
+  //! \param A The element matrix to add to
+  bool addElementMatrix(size_t iel, double sigma, double kappa,
+                        Matrix& A) const;
+
+  //! \brief Computes the element extraction operators of a knot vector.
+  //! \param[in] knots Knot vector
+  //! \param[in] order Spline order
+  //! \param[out] C Extraction operator of each non-zero knot span
+  //! \note The knot vector must be open, as for all patches of the models.
+  static bool extract(const std::vector<double>& knots, int order,
+                      std::vector<Matrix>& C);
+
+  //! \brief Computes the Bernstein mass and stiffness tables on [0,1].
+  //! \param[in] p Polynomial degree
+  //! \param[out] M Mass table
+  //! \param[out] K Stiffness table
+  static void bernstein(int p, Matrix& M, Matrix& K);
+
+private:
+  //! \brief Adds the Kronecker products of the univariate matrices.
+  //! \param[in] cls Univariate class index in each direction
+  //! \param[in] sigma Mass coefficient
+  //! \param[in] kappa Diffusion coefficient
+  //! \param A The element matrix to add to
+  void tensor(const size_t* cls, double sigma, double kappa, Matrix& A) const;
+
+  //! \brief Univariate element matrices of a parameter direction.
+  struct Direction
+  {
+    size_t n = 0;            //!< Number of basis functions per element
+    std::vector<size_t> cls; //!< Class index of each knot span
+    std::vector<Matrix> M;   //!< Element mass matrix of each class
+    std::vector<Matrix> K;   //!< Element stiffness matrix of each class
+  };
+
+  std::vector<Direction> dirs; //!< The parameter directions
+
+  std::vector<size_t> elmCls; //!< Congruence class of each element
+  std::vector<Matrix> clsM;   //!< Mass matrix of each congruence class
+  std::vector<Matrix> clsK;   //!< Stiffness matrix of each congruence class
+};
+
+#endif
@@ -0,0 +1,57 @@
+// $Id$
+//==============================================================================
+//!
+//! \file ADCachedFunc.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Time-independent function with cached point values.
+//!
+//==============================================================================
+
+#ifndef _AD_CACHED_FUNC_H
+#define _AD_CACHED_FUNC_H
+
+#include "Function.h"
+#include <array>
+#include <map>
+#include <memory>
+
+
+/*!
+  \brief Real-valued function caching the values of a time-independent one.
+  \details The wrapped function is evaluated once for each distinct spatial
+  point, and later evaluations at that point return the stored value. This is
+  intended for constant Dirichlet conditions, which are then not re-evaluated
+  at the boundary nodes in every time step, while the time-dependent ones are.
+  The cache is not synchronized, so concurrent evaluations are not supported.
+*/
+
+class ADCachedFunc : public RealFunc
+{
+public:
+  //! \brief The constructor takes ownership of the wrapped function.
+  //! \param[in] f The time-independent function to cache the values of
+  explicit ADCachedFunc(RealFunc* f) : func(f) {}
+  //! \brief Empty destructor.
+  virtual ~ADCachedFunc() {}
+
+  //! \brief Returns \e true, since the wrapped function is time-independent.
+  bool isConstant() const override { return true; }
+
+  //! \brief Returns the number of cached point values.
+  size_t size() const { return cache.size(); }
+
+protected:
+  //! \brief Evaluates the function at a spatial point.
+  //! \param[in] X Spatial point, time is ignored if a Vec4
+  Real evaluate(const Vec3& X) const override;
+
+private:
+  std::unique_ptr<RealFunc> func; //!< The wrapped function
+  mutable std::map<std::array<Real,3>,Real> cache; //!< Cached point values
+};
+
+#endif
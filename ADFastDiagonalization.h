@@ -0,0 +1,103 @@
+// $Id$
+//==============================================================================
+//!
+//! \file ADFastDiagonalization.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Fast diagonalization of tensor-product mass and stiffness operators.
+//!
+//==============================================================================
+
+#ifndef _AD_FAST_DIAGONALIZATION_H
+#define _AD_FAST_DIAGONALIZATION_H
+
+#include "MatVec.h"
+#include <vector>
+
+
+/*!
+  \brief Class applying the inverse of a tensor-product spline operator.
+  \details On a box-shaped single-patch spline model, the operator
+  \f$\sigma M + \kappa K\f$ is a sum of Kronecker products of the univariate
+  mass and stiffness matrices. With the generalized eigendecomposition
+  \f$K_d S_d = M_d S_d \Lambda_d\f$, \f$S_d^T M_d S_d = I\f$ in each
+  direction, the inverse is
+
+  \f[ (\sigma M + \kappa K)^{-1} = (\otimes_d S_d)\,
+      (\sigma I + \kappa \oplus_d \Lambda_d)^{-1} (\otimes_d S_d)^T \f]
+
+  The eigendecompositions are computed once. Each application is a sequence
+  of dense univariate transforms, costing \f$O(n^{(d+1)/d})\f$ for \a n
+  unknowns in \a d dimensions.
+
+  The basis functions at boundaries with Dirichlet conditions are left out
+  of the univariate matrices, and the corresponding values are zero.
+*/
+
+class ADFastDiagonalization
+{
+public:
+  //! \brief Default constructor.
+  ADFastDiagonalization() {}
+
+  //! \brief Computes the univariate matrices and their eigendecompositions.
+  //! \param[in] knots Knot vector in each parameter direction
+  //! \param[in] order Spline order (degree + 1) in each direction
+  //! \param[in] length Physical length of the box in each direction
+  //! \param[in] fixed Dirichlet flags of the lower and upper boundary
+  //! in each direction
+  bool init(const std::vector<std::vector<double>>& knots,
+            const std::vector<int>& order,
+            const std::vector<double>& length,
+            const std::vector<std::pair<bool,bool>>& fixed);
+
+  //! \brief Defines the operator coefficients.
+  //! \param[in] s Mass coefficient
+  //! \param[in] k Diffusion coefficient
+  void setCoefficients(double s, double k) { sigma = s; kappa = k; }
+
+  //! \brief Applies the inverse operator.
+  //! \param[in] in Nodal values, with the first direction running fastest
+  //! \param[out] out The inverse operator applied to \a in
+  bool apply(const Vector& in, Vector& out) const;
+
+  //! \brief Returns \e true if the decomposition has been computed.
+  bool empty() const { return dirs.empty(); }
+  //! \brief Returns the number of nodes in the tensor grid.
+  size_t size() const;
+
+  //! \brief Computes the univariate B-spline mass and stiffness matrices.
+  //! \param[in] knots Knot vector
+  //! \param[in] order Spline order
+  //! \param[in] length Physical length of the parameter domain
+  //! \param[out] M Mass matrix
+  //! \param[out] K Stiffness matrix
+  static void assemble1D(const std::vector<double>& knots, int order,
+                         double length, Matrix& M, Matrix& K);
+
+  //! \brief Solves the generalized symmetric eigenproblem \a K S = \a M S L.
+  //! \param[in] K Symmetric matrix
+  //! \param[in] M Symmetric positive definite matrix
+  //! \param[out] S Eigenvectors, normalized such that S^T M S = I
+  //! \param[out] L Eigenvalues
+  static bool eigen(const Matrix& K, const Matrix& M, Matrix& S, Vector& L);
+
+private:
+  //! \brief Univariate data of a parameter direction.
+  struct Direction
+  {
+    size_t n = 0;     //!< Number of basis functions
+    size_t first = 0; //!< First free basis function
+    Matrix S;         //!< Eigenvectors of the free basis functions
+    Vector L;         //!< Eigenvalues
+  };
+
+  std::vector<Direction> dirs; //!< The parameter directions
+  double sigma = 1.0; //!< Mass coefficient
+  double kappa = 1.0; //!< Diffusion coefficient
+};
+
+#endif
@@ -0,0 +1,63 @@
+// $Id$
+//==============================================================================
+//!
+//! \file ADFlowReader.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Reader for stored flow fields with asynchronous frame prefetch.
+//!
+//==============================================================================
+
+#ifndef _AD_FLOW_READER_H
+#define _AD_FLOW_READER_H
+
+#include "ADFrameStream.h"
+#include "MatVec.h"
+#include <string>
+
+class TiXmlElement;
+
+
+/*!
+  \brief Class reading velocity snapshots from the HDF5 output of a flow run.
+  \details Each time level of the HDF5 file is one frame, holding the nodal
+  velocity values of a single patch, with the time of the level stored in a
+  separate dataset. The velocity at a given time is interpolated linearly
+  between the two surrounding levels. Upcoming levels are read in a
+  background thread, such that the time stepping does not wait on I/O as long
+  as the reading keeps up with the simulation.
+*/
+
+class ADFlowReader : public ADFrameStream
+{
+public:
+  //! \brief The constructor parses the reader parameters and opens the file.
+  //! \param[in] elem The XML element with the reader definition
+  explicit ADFlowReader(const TiXmlElement* elem);
+  //! \brief The destructor closes the file.
+  virtual ~ADFlowReader();
+
+  //! \brief Returns \e true if the flow record was successfully opened.
+  bool isValid() const { return !times.empty(); }
+
+  //! \brief Interpolates the stored velocity at the given time.
+  //! \param[in] t The time to interpolate at
+  //! \param[out] u Nodal velocity values
+  bool interpolate(double t, Vector& u);
+
+protected:
+  //! \brief Reads the velocity of a time level.
+  //! \param[in] i 0-based time level
+  //! \param[out] data Nodal velocity values
+  bool readFrame(size_t i, std::vector<double>& data) override;
+
+private:
+  long long file;          //!< HDF5 file handle
+  std::string field;       //!< Dataset path of the velocity within a level
+  std::vector<double> times; //!< Time of each level
+};
+
+#endif
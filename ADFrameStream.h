@@ -0,0 +1,105 @@
+// $Id$
+//==============================================================================
+//!
+//! \file ADFrameStream.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Bounded window of data frames with background prefetching.
+//!
+//==============================================================================
+
+#ifndef _AD_FRAME_STREAM_H
+#define _AD_FRAME_STREAM_H
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/*!
+  \brief Base class for sequential access to a long record of data frames.
+  \details Only a bounded window of frames is kept in memory. When a frame is
+  requested, the following frames are read by a background thread, such that
+  they are available when the caller advances. If a requested frame is not
+  yet available, it is read synchronously and counted as a stall.
+
+  Sub-classes implement readFrame(). It is never invoked concurrently, but
+  may be invoked from the background thread, so it must not use resources
+  shared with other code unless these are thread-safe.
+*/
+
+class ADFrameStream
+{
+public:
+  //! \brief Shared pointer to a frame.
+  typedef std::shared_ptr<const std::vector<double>> Frame;
+
+  //! \brief The constructor initializes the window parameters.
+  //! \param[in] window Maximum number of frames kept in memory
+  //! \param[in] ahead Number of frames to prefetch ahead of the current one
+  ADFrameStream(size_t window, size_t ahead);
+  //! \brief The destructor stops the background thread.
+  //! \details Sub-classes must call stop() in their own destructor,
+  //! since readFrame() may be in use by the background thread.
+  virtual ~ADFrameStream();
+
+  //! \brief Starts the stream.
+  //! \param[in] frames Total number of frames in the record
+  //! \param[in] async If \e true, prefetch in a background thread
+  void start(size_t frames, bool async);
+  //! \brief Stops the background thread.
+  void stop();
+  //! \brief Changes the window parameters.
+  //! \details Must be invoked before start().
+  //! \param[in] window Maximum number of frames kept in memory
+  //! \param[in] ahead Number of frames to prefetch ahead of the current one
+  void setWindow(size_t window, size_t ahead);
+
+  //! \brief Returns a frame, reading it if not already available.
+  //! \param[in] i 0-based frame index
+  //! \return Null pointer if the frame could not be read
+  Frame getFrame(size_t i);
+
+  //! \brief Returns the total number of frames.
+  size_t size() const { return nFrames; }
+  //! \brief Returns the number of frames that had to be read synchronously.
+  size_t getStalls() const { return nStalls; }
+
+protected:
+  //! \brief Reads a frame from the record.
+  //! \param[in] i 0-based frame index
+  //! \param[out] data The frame data
+  virtual bool readFrame(size_t i, std::vector<double>& data) = 0;
+
+private:
+  //! \brief Reads a frame, serializing access to readFrame().
+  Frame load(size_t i);
+  //! \brief Removes the frames outside the window.
+  void evict();
+  //! \brief The prefetching loop of the background thread.
+  void worker();
+
+  size_t nFrames = 0; //!< Total number of frames
+  size_t window;      //!< Maximum number of frames in memory
+  size_t ahead;       //!< Number of frames to prefetch
+  size_t current = 0; //!< Index of the most recently requested frame
+  size_t loading;     //!< Index of the frame being read in the background
+  size_t failed;      //!< Index of a frame the background thread failed to read
+  size_t nStalls = 0; //!< Number of synchronous reads
+
+  std::map<size_t,Frame> frames; //!< The frames in memory
+  std::mutex mtx;                //!< Protects the window data
+  std::mutex ioMtx;              //!< Serializes readFrame() calls
+  std::condition_variable wake;  //!< Wakes up the background thread
+  std::condition_variable done;  //!< Signals a completed background read
+  std::thread thread;            //!< The background thread
+  bool stopping = false;         //!< True when the thread should exit
+};
+
+#endif
@@ -0,0 +1,67 @@
+// $Id$
+//==============================================================================
+//!
+//! \file ADGMRES.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Restarted GMRES for operators given as callbacks.
+//!
+//==============================================================================
+
+#ifndef _AD_GMRES_H
+#define _AD_GMRES_H
+
+#include "MatVec.h"
+#include <functional>
+
+
+/*!
+  \brief Class implementing right-preconditioned, restarted GMRES.
+  \details The operator and the preconditioner are given as callbacks, such
+  that neither has to be available as an assembled matrix. The iterations
+  work on the vectors as given, i.e., in equation ordering when used with
+  assembled systems and in nodal ordering for period maps.
+*/
+
+class ADGMRES
+{
+public:
+  //! \brief Operator callback, computing \a y = op(\a x).
+  typedef std::function<bool(const Vector& x, Vector& y)> Operator;
+
+  //! \brief The constructor initializes the iteration parameters.
+  //! \param[in] tol Relative residual tolerance
+  //! \param[in] maxIt Maximum number of iterations
+  //! \param[in] restart Number of iterations between restarts
+  explicit ADGMRES(double tol = 1.0e-8, int maxIt = 100, int restart = 30)
+    : rTol(tol), maxIter(maxIt), kdim(restart) {}
+
+  //! \brief Solves \a A \a x = \a b.
+  //! \param[in] A The operator
+  //! \param[in] P The preconditioner (approximate inverse of \a A), or null
+  //! \param[in] b The right-hand-side vector
+  //! \param x Initial guess on input, solution on output
+  //! \return \e false if a callback failed
+  bool solve(const Operator& A, const Operator& P, const Vector& b,
+             Vector& x);
+
+  //! \brief Returns the number of iterations of the last solve.
+  int getIterations() const { return nIter; }
+  //! \brief Returns the relative residual of the last solve.
+  double getResidual() const { return relRes; }
+  //! \brief Returns \e true if the last solve converged.
+  bool converged() const { return relRes <= rTol; }
+
+private:
+  double rTol;    //!< Relative residual tolerance
+  int    maxIter; //!< Maximum number of iterations
+  int    kdim;    //!< Number of iterations between restarts
+
+  int    nIter = 0;    //!< Number of iterations of the last solve
+  double relRes = 0.0; //!< Relative residual of the last solve
+};
+
+#endif
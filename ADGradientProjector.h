@@ -0,0 +1,134 @@
+// $Id$
+//==============================================================================
+//!
+//! \file ADGradientProjector.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Global L2 projection of temperature gradients with reused factorization.
+//!
+//==============================================================================
+
+#ifndef _AD_GRADIENT_PROJECTOR_H
+#define _AD_GRADIENT_PROJECTOR_H
+
+#include "IntegrandBase.h"
+#include "GlobalIntegral.h"
+#include "ElmMats.h"
+#include <memory>
+
+class ASMbase;
+class AdvectionDiffusion;
+class SparseMatrix;
+class TimeDomain;
+
+
+/*!
+  \brief Class for continuous global L2 projection of temperature gradients.
+  \details The projection mass matrix only depends on the mesh. It is
+  assembled and factorized on the first projection, and the factorization is
+  then reused for every component and every later projection until clear()
+  is invoked. Only the right-hand-side vectors are assembled per call.
+
+  The gradients are evaluated by AdvectionDiffusion::evalSolElm() once per
+  element, for all quadrature points in one product. The right-hand sides are
+  then formed by one matrix product with the weighted basis function values.
+*/
+
+class ADGradientProjector : public IntegrandBase
+{
+public:
+  //! \brief The constructor initializes the problem integrand reference.
+  //! \param ad The integrand evaluating the temperature gradients
+  explicit ADGradientProjector(AdvectionDiffusion& ad);
+  //! \brief The destructor frees the factorized projection matrix.
+  virtual ~ADGradientProjector();
+
+  //! \brief Projects the gradient of a scalar field onto the primary basis.
+  //! \param[out] ssol Projected gradient, one row for each component
+  //! \param[in] psol Primary (temperature) solution vector
+  //! \param[in] model The patches of the model
+  //! \param[in] nnod Total number of nodes in the model
+  //! \param[in] time Time domain for the projection
+  //! \return \e false if no sparse direct solver is available
+  //!
+  //! \details The patch solutions are extracted into the problem integrand.
+  bool project(Matrix& ssol, const Vector& psol,
+               const std::vector<ASMbase*>& model, size_t nnod,
+               const TimeDomain& time);
+
+  //! \brief Drops the cached projection matrix, e.g., after mesh changes.
+  void clear();
+
+  using IntegrandBase::getLocalIntegral;
+  //! \brief Returns a local integral container for the given element.
+  //! \param[in] nen Number of nodes on element
+  LocalIntegral* getLocalIntegral(size_t nen, size_t,
+                                  bool) const override;
+
+  using IntegrandBase::initElement;
+  //! \brief Initializes current element for numerical integration.
+  //! \param[in] MNPC Matrix of nodal point correspondance for current element
+  //! \param A Local integral for element
+  bool initElement(const std::vector<int>& MNPC, LocalIntegral& A) override;
+
+  using IntegrandBase::evalInt;
+  //! \brief Evaluates the integrand at an interior point.
+  //! \param elmInt The local integral object to receive the contributions
+  //! \param[in] fe Finite element data of current integration point
+  //! \param[in] X Cartesian coordinates of current integration point
+  bool evalInt(LocalIntegral& elmInt, const FiniteElement& fe,
+               const Vec3& X) const override;
+
+  using IntegrandBase::finalizeElement;
+  //! \brief Evaluates the gradients and right-hand sides of an element.
+  //! \param A Local integral for element
+  bool finalizeElement(LocalIntegral& A) override;
+
+  //! \brief Returns the number of primary/secondary solution field components.
+  size_t getNoFields(int fld = 1) const override { return fld > 1 ? nsd : 1; }
+
+protected:
+  //! \brief Class representing the element matrices of the projection.
+  class ElementInfo : public ElmMats
+  {
+  public:
+    //! \brief Default constructor.
+    explicit ElementInfo(bool lhs) : ElmMats(lhs) {}
+    //! \brief Empty destructor.
+    virtual ~ElementInfo() {}
+
+    std::vector<int> nodes; //!< Global node numbers (1-based) of the element
+    std::vector<int> MNPC;  //!< Patch-local node numbers of the element
+    std::vector<Real> dNdX; //!< Basis function gradients of all points
+    std::vector<Real> NxW;  //!< Weighted basis function values of all points
+  };
+
+  //! \brief Class assembling the element contributions into the global system.
+  class Assembler : public GlobalIntegral
+  {
+  public:
+    //! \brief The constructor initializes the global system references.
+    Assembler(SparseMatrix* A, Vectors& B) : mass(A), rhs(B) {}
+    //! \brief Empty destructor.
+    virtual ~Assembler() {}
+
+    //! \brief Adds an element contribution to the global system.
+    //! \param[in] elmObj The element contribution
+    bool assemble(const LocalIntegral* elmObj, int) override;
+
+  private:
+    SparseMatrix* mass; //!< Projection matrix, null if already factorized
+    Vectors&      rhs;  //!< Right-hand-side vectors, one for each component
+  };
+
+private:
+  AdvectionDiffusion& problem; //!< The problem integrand
+  std::unique_ptr<SparseMatrix> A; //!< The projection matrix
+  bool factorized; //!< True when \a A holds a valid factorization
+  const ASMbase* patch; //!< The patch currently being integrated
+};
+
+#endif
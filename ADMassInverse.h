@@ -0,0 +1,83 @@
+// $Id$
+//==============================================================================
+//!
+//! \file ADMassInverse.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Approximate consistent mass inverse by fixed lumped-preconditioned iterations.
+//!
+//==============================================================================
+
+#ifndef _AD_MASS_INVERSE_H
+#define _AD_MASS_INVERSE_H
+
+#include "SystemMatrix.h"
+
+class TiXmlElement;
+
+
+/*!
+  \brief Class applying an approximate inverse of a consistent mass matrix.
+  \details A fixed number of Jacobi or Chebyshev iterations, preconditioned
+  by the row-sum lumped mass matrix, is performed. Each iteration costs one
+  matrix-vector product with the mass matrix, so no factorization is needed.
+  With non-negative basis functions the spectrum of the preconditioned mass
+  matrix lies within (0,1]. The lower bound used by the Chebyshev iterations
+  is estimated once by power iterations.
+
+  The lumped diagonal and the spectral bound only depend on the mesh.
+  They are computed on the first application and kept until clear() is
+  invoked.
+*/
+
+class ADMassInverse
+{
+public:
+  //! \brief Enum defining the available iteration methods.
+  enum Method {
+    NONE      = 0, //!< Use the linear equation solver
+    JACOBI    = 1, //!< Lumped-preconditioned Jacobi iterations
+    CHEBYSHEV = 2  //!< Lumped-preconditioned Chebyshev iterations
+  };
+
+  //! \brief Default constructor.
+  ADMassInverse() {}
+
+  //! \brief Parses the iteration parameters from an XML element.
+  bool parse(const TiXmlElement* elem);
+
+  //! \brief Returns \e true if the approximate inverse is to be used.
+  bool enabled() const { return method != NONE && nIt > 0; }
+
+  //! \brief Drops the cached lumped mass, e.g., after mesh changes.
+  void clear() { invDiag.clear(); }
+
+  //! \brief Returns \e true if the lumped mass has been computed.
+  //! \details The consistent mass matrix is then also assembled, and does
+  //! not need to be assembled again until clear() is invoked.
+  bool initialized() const { return !invDiag.empty(); }
+
+  //! \brief Applies the approximate inverse.
+  //! \param[in] M The consistent mass matrix
+  //! \param[in] b The right-hand-side vector
+  //! \param[out] x The approximate solution of \a M \a x = \a b
+  bool apply(const SystemMatrix& M, const SystemVector& b, StdVector& x);
+
+protected:
+  //! \brief Computes the inverse lumped mass and the spectral bounds.
+  //! \param[in] M The consistent mass matrix
+  bool initialize(const SystemMatrix& M);
+
+private:
+  int method = NONE; //!< Iteration method
+  int nIt = 0;       //!< Number of iterations
+
+  StdVector invDiag;   //!< Inverse of the row-sum lumped mass matrix
+  double lmin = 0.0;   //!< Lower spectral bound of the preconditioned matrix
+  double lmax = 1.0;   //!< Upper spectral bound of the preconditioned matrix
+};
+
+#endif
@@ -0,0 +1,140 @@
+// $Id$
+//==============================================================================
+//!
+//! \file ADShmChannel.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Field exchange with a local process through POSIX shared memory.
+//!
+//==============================================================================
+
+#ifndef _AD_SHM_CHANNEL_H
+#define _AD_SHM_CHANNEL_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+
+/*!
+  \brief Class for one-directional field exchange through shared memory.
+  \details The channel is a memory mapped POSIX shared memory segment holding
+  two slots of field values, such that the reader can use the field of the
+  previous step while the writer fills in the next one. Both processes map
+  the same segment, and the values are read in place, without copying.
+
+  The writer owns the segment. It removes any segment left with the same name
+  by an earlier run, creates a new one with reset counters, and removes it
+  again when closed. The header carries a format version and a session
+  number, which the coupled processes use to check that all their channels
+  belong to the same run. The reader attaches to the segment once the writer
+  has initialized it.
+
+  The handshake uses two lock-free counters. The writer publishes step \a n
+  in slot \a n%2 by incrementing \a seq. The reader acknowledges a step by
+  setting \a ack when it no longer needs the field of the previous step.
+  Before writing step \a n, the writer waits until step \a n-1 has been
+  acknowledged, since the slot then holds step \a n-2.
+*/
+
+class ADShmChannel
+{
+public:
+  //! \brief Default constructor.
+  ADShmChannel() {}
+  //! \brief The destructor closes the segment.
+  ~ADShmChannel();
+
+  //! \brief Creates a new shared memory segment as its writer.
+  //! \param[in] name Name of the segment (starting with a slash)
+  //! \param[in] nval Number of field values per slot
+  //! \param[in] session Session number identifying the coupled run
+  //! \details An existing segment with the same name is removed first.
+  bool create(const std::string& name, size_t nval, uint64_t session);
+  //! \brief Attaches to a shared memory segment as its reader.
+  //! \param[in] name Name of the segment (starting with a slash)
+  //! \param[in] nval Number of field values per slot
+  //! \param[in] timeout Maximum time to wait for the writer in seconds
+  //! \return \e false if the segment was not initialized within \a timeout,
+  //! or if it has a different format or size
+  bool attach(const std::string& name, size_t nval, double timeout);
+  //! \brief Unmaps the segment.
+  //! \details The writer also marks the segment as closed and removes it.
+  void close();
+
+  //! \brief Returns a new session number.
+  static uint64_t newSession();
+
+  //! \brief Returns \e true if the segment is mapped.
+  bool isOpen() const { return header != nullptr; }
+  //! \brief Returns the number of field values per slot.
+  size_t size() const { return nValues; }
+  //! \brief Returns the session number of the segment.
+  uint64_t getSession() const { return session; }
+
+  //! \brief Returns the slot to write step \a n into.
+  //! \details Waits until the reader has acknowledged step \a n-1.
+  //! \param[in] n Step number (1-based)
+  //! \param[in] timeout Maximum time to wait in seconds
+  //! \return Null pointer if the wait timed out
+  double* beginWrite(uint64_t n, double timeout);
+  //! \brief Publishes step \a n.
+  //! \param[in] n Step number (1-based)
+  //! \param[in] t Time of the step
+  void endWrite(uint64_t n, double t);
+
+  //! \brief Returns the field of step \a n, waiting for it if necessary.
+  //! \param[in] n Step number (1-based)
+  //! \param[in] timeout Maximum time to wait in seconds
+  //! \return Null pointer if the wait timed out, or if the writer has closed
+  //! the segment or reinitialized it for another session
+  const double* read(uint64_t n, double timeout);
+  //! \brief Returns the field of an already published step.
+  //! \param[in] n Step number (1-based)
+  const double* slot(uint64_t n) const;
+  //! \brief Returns the time of an already published step.
+  //! \param[in] n Step number (1-based)
+  double time(uint64_t n) const;
+  //! \brief Acknowledges that the reader is done with step \a n-1.
+  //! \param[in] n Step number (1-based)
+  void acknowledge(uint64_t n);
+
+private:
+  //! \brief Header of the shared memory segment.
+  struct Header
+  {
+    std::atomic<uint64_t> magic;   //!< Format version, zero when not valid
+    std::atomic<uint64_t> session; //!< Session number of the coupled run
+    std::atomic<uint64_t> nval;    //!< Number of values per slot
+    std::atomic<uint64_t> seq;     //!< Last published step
+    std::atomic<uint64_t> ack;     //!< Last acknowledged step
+    double time[2];                //!< Time of the step in each slot
+  };
+
+  //! \brief Maps an opened segment.
+  //! \param[in] fd File descriptor of the segment
+  //! \param[in] name Name of the segment
+  //! \param[in] nval Number of field values per slot
+  bool map(int fd, const std::string& name, size_t nval);
+
+  //! \brief Returns \e true if the segment still belongs to this session.
+  bool isValid() const;
+
+  //! \brief Waits until a counter reaches a given value.
+  //! \details Gives up if the segment is no longer valid.
+  bool waitFor(const std::atomic<uint64_t>& counter, uint64_t value,
+               double timeout) const;
+
+  Header* header = nullptr; //!< The mapped segment
+  double* data = nullptr;   //!< Start of the field slots
+  size_t  nValues = 0;      //!< Number of values per slot
+  size_t  bytes = 0;        //!< Size of the mapped segment
+  uint64_t session = 0;     //!< Session number of the segment
+  bool    owner = false;    //!< If \e true, this is the writer side
+  std::string segName;      //!< Name of the segment
+};
+
+#endif
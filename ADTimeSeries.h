@@ -0,0 +1,130 @@
+// $Id$
+//==============================================================================
+//!
+//! \file ADTimeSeries.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Time-dependent function interpolated from a tabulated HDF5 series.
+//!
+//==============================================================================
+
+#ifndef _AD_TIME_SERIES_H
+#define _AD_TIME_SERIES_H
+
+#include "Function.h"
+#include "ADFrameStream.h"
+#include <memory>
+#include <string>
+
+class TiXmlElement;
+
+
+/*!
+  \brief Real-valued function interpolating a measured time series.
+  \details The series is read from an HDF5 file containing the datasets
+  \a time (sample times, increasing) and \a values (one row per sample, one
+  column per signal) in the group given by \a path. The samples are read in
+  blocks, of which only a bounded window is kept in memory, and upcoming
+  blocks are prefetched in a background thread.
+
+  The value is interpolated linearly or by cubic Hermite splines in time, and
+  is constant outside the recorded interval. It can optionally be multiplied
+  by a spatial profile expression.
+
+  The samples needed within a time step are copied by setTimeInterval()
+  before the assembly. Evaluations within that interval then only read the
+  copy, so concurrent evaluations need no synchronization. Evaluations
+  outside the interval read the samples from the block reader.
+*/
+
+class ADTimeSeries : public RealFunc
+{
+public:
+  //! \brief The constructor parses the series definition from XML.
+  //! \param[in] elem The XML element with the series definition
+  explicit ADTimeSeries(const TiXmlElement* elem);
+  //! \brief The destructor stops the prefetching.
+  virtual ~ADTimeSeries();
+
+  //! \brief Returns \e true if the series was successfully opened.
+  bool isValid() const { return nSamples > 0; }
+
+  //! \brief Returns \e false, since the function varies in time.
+  bool isConstant() const override { return false; }
+
+  //! \brief Copies the samples needed to evaluate the series in an interval.
+  //! \param[in] t0 Start of the time interval
+  //! \param[in] t1 End of the time interval
+  //! \details Must not be invoked concurrently with evaluations.
+  bool setTimeInterval(double t0, double t1);
+
+  //! \brief Returns the interpolated series value at time \a t.
+  double getValue(double t) const;
+
+protected:
+  //! \brief Evaluates the function at a spatial point.
+  //! \param[in] X Spatial point, including time if a Vec4
+  Real evaluate(const Vec3& X) const override;
+
+private:
+  //! \brief Class reading blocks of samples from the HDF5 file.
+  class Reader : public ADFrameStream
+  {
+  public:
+    //! \brief The constructor opens the file.
+    //! \param[in] file Name of the HDF5 file
+    //! \param[in] path Group containing the datasets
+    //! \param[in] column Column of the values dataset to read
+    //! \param[in] block Number of samples per block
+    //! \param[in] window Maximum number of blocks in memory
+    //! \param[in] ahead Number of blocks to prefetch
+    Reader(const std::string& file, const std::string& path,
+           size_t column, size_t block, size_t window, size_t ahead);
+    //! \brief The destructor closes the file.
+    virtual ~Reader();
+
+    //! \brief Reads the time of every \a block sample.
+    //! \param[out] times Start time of each block
+    //! \return Total number of samples, zero on failure
+    size_t readBlockTimes(std::vector<double>& times);
+
+  protected:
+    //! \brief Reads a block of sample times and values.
+    //! \param[in] i 0-based block index
+    //! \param[out] data Sample times followed by sample values
+    bool readFrame(size_t i, std::vector<double>& data) override;
+
+  private:
+    long long file;    //!< HDF5 file handle
+    std::string path;  //!< Group containing the datasets
+    size_t column;     //!< Column of the values dataset to read
+    size_t block;      //!< Number of samples per block
+    size_t nSamples;   //!< Total number of samples
+  };
+
+  //! \brief Returns a sample time and value.
+  //! \param[in] n 0-based sample index
+  //! \param[out] t Sample time
+  //! \param[out] v Sample value
+  bool getSample(size_t n, double& t, double& v) const;
+
+  //! \brief Returns the index of the last sample at or before time \a t.
+  //! \details Returns 0 if \a t is before the first sample.
+  size_t findSample(double t) const;
+
+  std::unique_ptr<Reader> reader;  //!< Block reader
+  std::unique_ptr<RealFunc> profile; //!< Optional spatial profile
+  std::vector<double> blockTime;   //!< Start time of each block
+  size_t nSamples = 0;             //!< Total number of samples
+  size_t block = 4096;             //!< Number of samples per block
+  bool cubic = false;              //!< If \e true, use cubic interpolation
+
+  size_t firstSample = 0;         //!< Index of the first copied sample
+  std::vector<double> sampleTime; //!< Copied sample times
+  std::vector<double> sampleVal;  //!< Copied sample values
+};
+
+#endif
@@ -19,6 +19,7 @@
 #include "EqualOrderOperators.h"
 #include "ADFluidProperties.h"
 
+class ADBezierExtraction;
 class RealFunc;
 class VecFunc;
 
@@ -122,7 +123,10 @@ public:
   virtual ~AdvectionDiffusion();
 
   //! \brief Defines the source function.
+  //! \details The integrand takes ownership of the function.
   void setSource(RealFunc* src) { source = src; }
+  //! \brief Returns \e true if a source function is defined.
+  bool hasSource() const { return source != nullptr; }
 
   //! \brief Defines the Cinv stabilization parameter.
   void setCinv(double Cinv_) { Cinv = Cinv_; }
@@ -150,6 +154,34 @@ public:
   //! \brief Sets the basis order.
   void setOrder(int p) { order = p; }
 
+  //! \brief Defines the CFL number of the local pseudo time steps.
+  //! \details A positive value adds a pseudo time derivative to the
+  //! stationary problem, with the time step in each point given by the CFL
+  //! number and the local advective and diffusive time scales.
+  //! The previous pseudo time level is the primary solution.
+  void setPseudoTimeStep(double cfl) { ptcCFL = cfl; }
+
+  //! \brief Defines the Bezier extraction tables of the patch.
+  //! \details When set, the constant-coefficient mass and diffusion terms
+  //! are added once per element from the tables, instead of by quadrature.
+  void setBezierExtraction(const ADBezierExtraction* tab) { bezier = tab; }
+
+  //! \brief Enum defining the element vector contents for matrix-free solves.
+  enum MatrixFree {
+    ASSEMBLED = 0, //!< Regular element matrix and vector
+    RESIDUAL  = 1, //!< Element residual of the primary solution
+    OPERATOR  = 2  //!< Element matrix times the primary solution
+  };
+
+  //! \brief Selects the element vector contents for matrix-free solves.
+  //! \return \e false if the integrand does not support matrix-free solves
+  virtual bool setMatrixFree(MatrixFree) { return false; }
+
+  //! \brief Returns the mass and diffusion coefficients of the operator.
+  //! \return \e false if the integrand does not provide the coefficients
+  virtual bool getOperatorCoefficients(double, double&, double&) const
+  { return false; }
+
   //! \brief Returns a previously calculated tau value for the given element.
   //! \brief param[in] e The element number
   //! \details Used with norm calculations
@@ -198,6 +230,18 @@ public:
   bool evalSol(Vector& s, const FiniteElement& fe,
                const Vec3& X, const std::vector<int>& MNPC) const override;
 
+  //! \brief Evaluates the secondary solution at all result points of an element.
+  //! \param[out] s Temperature gradients, \a nsd values for each point
+  //! \param[in] dNdX Basis function gradients for all points of the element,
+  //! stored as a \a nen &times; \a nsd*npt matrix with the \a nsd columns of
+  //! each point stored consecutively
+  //! \param[in] MNPC Nodal point correspondance for the basis function values
+  //!
+  //! \details The element solution vector is gathered once, and all gradients
+  //! are then computed by a single matrix-vector product.
+  bool evalSolElm(Vector& s, const Matrix& dNdX,
+                  const std::vector<int>& MNPC) const;
+
   //! \brief Returns the number of primary/secondary solution field components.
   //! \param[in] fld which field set to consider (1=primary, 2=secondary)
   size_t getNoFields(int fld = 1) const override { return fld > 1 ? nsd : 1; }
@@ -219,6 +263,26 @@ public:
   //! \brief Advances the integrand one time step forward.
   virtual void advanceStep() {}
 
+  //! \brief Defines a single precision storage for the oldest solution level.
+  //! \return \e false if the integrand does not support reduced precision
+  virtual bool setReducedHistory(const std::vector<float>*) { return false; }
+
+  //! \brief Defines externally owned storage for the advecting velocity.
+  //! \return \e false if the integrand does not support external velocities
+  virtual bool setExternalVelocity(const double*, const double*, size_t)
+  { return false; }
+
+  //! \brief Returns \e true if the system matrix is the mass matrix.
+  //! \details This is the case for explicit time integration, where the
+  //! linear systems are solved for the time derivative of the solution.
+  virtual bool hasMassSystem() const { return false; }
+
+  //! \brief Returns \e true if the element right-hand sides are premultiplied
+  //! by the inverse element mass matrices.
+  //! \details The assembled right-hand-side vector is then the time derivative
+  //! itself, and no linear system needs to be solved.
+  virtual bool hasLocalMassInverse() const { return false; }
+
   //! \brief Returns a reference to the fluid properties.
   AD::FluidProperties& getFluidProperties() { return props; }
   //! \brief Returns a const reference to the fluid properties.
@@ -241,6 +305,9 @@ protected:
 
   Stabilization stab; //!< The type of stabilization used
   double        Cinv; //!< Stabilization parameter
+  double      ptcCFL; //!< CFL number of pseudo time steps (0: stationary)
+
+  const ADBezierExtraction* bezier; //!< Element tables of the patch
 
   friend class AdvectionDiffusionNorm;
 };
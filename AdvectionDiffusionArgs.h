@@ -29,6 +29,17 @@ public:
   double errTol = 1e-6; //!< Error tolerance for embedded time stepping
   TimeIntegration::Method timeMethod = TimeIntegration::NONE; //!< Time integration method
   int integrandType = Integrand::STANDARD; //!< Integrand formulation
+  int formulation = 0; //!< Spatial formulation for explicit time stepping
+  int fsalPair = 0; //!< First-same-as-last Runge-Kutta pair (0: not used)
+  int abOrder = 0; //!< Order of Adams-Bashforth scheme (0: not used)
+  bool abCorrector = false; //!< If \e true, use Adams-Moulton corrector
+  bool rkc = false; //!< If \e true, use Runge-Kutta-Chebyshev time stepping
+  int rkcUpdate = 0; //!< Steps between spectral radius estimates for RKC
+  int nestedLevels = 0; //!< Number of coarser levels for nested iteration
+  double period = 0.0; //!< Period of the periodic steady state (0: not used)
+  double periodTol = 1.0e-6; //!< Relative tolerance of periodicity residual
+  int periodMaxIt = 10; //!< Maximum number of shooting iterations
+  int periodKrylov = 20; //!< Maximum number of GMRES iterations per shot
 
   //! \brief Default constructor.
   AdvectionDiffusionArgs() : SIMargsBase("advectiondiffusion") {}
@@ -77,6 +77,44 @@ public:
   //! \brief Advances the time stepping scheme.
   void advanceStep() override { bdf.advanceStep(); }
 
+  //! \brief Defines a single precision storage for the oldest solution level.
+  //! \details The values are expanded to double precision when gathered
+  //! into the element vectors in initElement().
+  bool setReducedHistory(const std::vector<float>* hist) override;
+
+  //! \brief Defines externally owned storage for the advecting velocity.
+  //! \param[in] u1 Nodal velocity values of the current level
+  //! \param[in] u2 Nodal velocity values of the previous level
+  //! \param[in] n Number of values in each array
+  //! \details The values are gathered directly from the given arrays, e.g.,
+  //! a shared memory segment, instead of the \a velocity vectors.
+  bool setExternalVelocity(const double* u1, const double* u2,
+                           size_t n) override;
+
+  //! \brief Selects the element vector contents for matrix-free solves.
+  //! \details In the matrix-free modes, the element matrix is applied to the
+  //! element vector of the primary solution in finalizeElement(), and only
+  //! the resulting element vector is assembled.
+  bool setMatrixFree(MatrixFree mode) override { mfMode = mode; return true; }
+
+  using AdvectionDiffusion::evalBou;
+  //! \brief Evaluates the integrand at a boundary point.
+  //! \param elmInt The local integral object to receive the contributions
+  //! \param[in] fe Finite element data of current integration point
+  //! \param[in] X Cartesian coordinates of current integration point
+  //! \param[in] normal Boundary normal vector at current integration point
+  //! \details The Neumann flux is a load, which is skipped when the element
+  //! vectors hold the operator applied to the primary solution.
+  bool evalBou(LocalIntegral& elmInt, const FiniteElement& fe,
+               const Vec3& X, const Vec3& normal) const override;
+
+  //! \brief Returns the coefficients of the symmetric part of the operator.
+  //! \param[in] dt Time step size
+  //! \param[out] sigma Coefficient of the mass matrix
+  //! \param[out] kappa Coefficient of the stiffness matrix
+  bool getOperatorCoefficients(double dt, double& sigma,
+                               double& kappa) const override;
+
   //! \brief Returns a pointer to an Integrand for solution norm evaluation.
   //! \note The Integrand object is allocated dynamically and has to be deleted
   //! manually when leaving the scope of the pointer variable receiving the
@@ -98,7 +136,11 @@ protected:
 
   Vectors velocity; //!< The advecting velocity field
   Vector  ux;       //!< Grid velocity (ALE)
+  const std::vector<float>* oldSol = nullptr; //!< Reduced precision history
   std::array<std::unique_ptr<Fields>,2> uFields; //!< Externally provided velocity fields
+  std::array<const double*,2> extVelocity{}; //!< Externally owned velocities
+  size_t extSize = 0; //!< Number of values in the external velocity arrays
+  MatrixFree mfMode = ASSEMBLED; //!< Element vector contents
 };
 
 #endif
@@ -21,21 +21,34 @@
   \brief Class representing the integrand of a time-dependent
          Advection-Diffusion problem.
   \details Time stepping is done using an explicit (RK type) method.
+  With the discontinuous Galerkin formulation the element mass matrices are
+  inverted once and applied locally. Only the right-hand-side vectors are
+  assembled, and the explicit stages are element-local.
 */
 
 class AdvectionDiffusionExplicit : public AdvectionDiffusion
 {
 public:
+  //! \brief Enum defining the available spatial formulations.
+  enum Formulation {
+    CG = 0, //!< Continuous Galerkin
+    DG = 1  //!< Upwind discontinuous Galerkin with SIPG diffusion
+  };
+
   //! \brief The default constructor initializes all pointers to zero.
   //! \param[in] n Number of spatial dimensions
   //! \param[in] itg_type The integrand type to use
   //! \param[in] form Integrand formulation
   AdvectionDiffusionExplicit(unsigned short int n = 3,
-                             int itg_type = STANDARD, int form = 0);
+                             int itg_type = STANDARD, int form = CG);
 
   //! \brief Empty destructor.
   virtual ~AdvectionDiffusionExplicit() {}
 
+  //! \brief Defines the global number of elements.
+  //! \details Also clears the cached inverse element mass matrices.
+  void setElements(size_t els);
+
   using AdvectionDiffusion::finalizeElement;
   //! \brief Finalizes the element quantities after the numerical integration.
   //! \details This method is invoked once for each element, after the numerical
@@ -43,6 +56,18 @@ public:
   //! element quantities are assembled into their system level equivalents.
   bool finalizeElement(LocalIntegral&) override;
 
+  using AdvectionDiffusion::initElement;
+  //! \brief Initializes current element for interface integration.
+  //! \param[in] MNPC1 Nodal point correspondance for the current element
+  //! \param[in] MNPC2 Nodal point correspondance for the neighbour element
+  //! \param A Local integral for element
+  //!
+  //! \details Extracts the solution of the current element into the first
+  //! element vector and that of the neighbour into the second.
+  bool initElement(const std::vector<int>& MNPC1,
+                   const std::vector<int>& MNPC2, size_t,
+                   LocalIntegral& A) override;
+
   using AdvectionDiffusion::evalInt;
   //! \brief Evaluates the integrand at an interior point.
   //! \param elmInt The local integral object to receive the contributions
@@ -51,6 +76,19 @@ public:
   bool evalInt(LocalIntegral& elmInt, const FiniteElement& fe,
                const Vec3& X) const override;
 
+  //! \brief Evaluates the integrand at an element interface point.
+  //! \param elmInt The local integral object to receive the contributions
+  //! \param[in] fe Finite element data of current integration point
+  //! \param[in] X Cartesian coordinates of current integration point
+  //! \param[in] normal Outward interface normal at current integration point
+  //!
+  //! \details Adds the upwind advective flux and the symmetric interior
+  //! penalty terms as seen from the current element. The neighbour trace is
+  //! evaluated by mirroring the element basis across the interface, which is
+  //! exact for C^-1 knot lines between congruent, axis-aligned elements.
+  bool evalInt(LocalIntegral& elmInt, const FiniteElement& fe,
+               const Vec3& X, const Vec3& normal) const override;
+
   using AdvectionDiffusion::getLocalIntegral;
   //! \brief Returns a local integral container for the given element.
   //! \param[in] nen Number of nodes on element
@@ -61,9 +99,18 @@ public:
   //! \brief Returns the integrand type.
   int getIntegrandType() const override
   {
-    return stab == NONE ? STANDARD : SECOND_DERIVATIVES | G_MATRIX;
+    int itgType = stab == NONE ? STANDARD : SECOND_DERIVATIVES | G_MATRIX;
+    if (formulation == DG)
+      itgType |= INTERFACE_TERMS | ELEMENT_CORNERS;
+    return itgType;
   }
 
+  //! \brief Returns \e true since the system matrix is the mass matrix.
+  bool hasMassSystem() const override { return true; }
+
+  //! \brief Returns \e true for the discontinuous Galerkin formulation.
+  bool hasLocalMassInverse() const override { return formulation == DG; }
+
   //! \brief Returns a pointer to an Integrand for solution norm evaluation.
   //! \note The Integrand object is allocated dynamically and has to be deleted
   //! manually when leaving the scope of the pointer variable receiving the
@@ -74,6 +121,18 @@ public:
   //! \brief Defines the solution mode before the element assembly is started.
   //! \param[in] mode The solution mode to use
   void setMode(SIM::SolutionMode mode) override;
+
+protected:
+  //! \brief Returns the index of the mirrored node across an interface.
+  //! \param[in] i Local node index (0-based)
+  //! \param[in] n Number of nodes in each parameter direction
+  //! \param[in] dir Parameter direction normal to the interface (0-based)
+  static size_t mirrorNode(size_t i, size_t n, size_t dir);
+
+  int    formulation; //!< Spatial formulation (CG or DG)
+  double penalty;     //!< Interior penalty constant for the DG formulation
+
+  Matrices invMass; //!< Cached inverse element mass matrices (DG only)
 };
 
 #endif
@@ -20,7 +20,19 @@
 #include "SIMconfigure.h"
 #include "Property.h"
 #include "ASMstruct.h"
+#include "ASMs2D.h"
+#include "ASMs3D.h"
 #include "AdvectionDiffusion.h"
+#include "ADBezierExtraction.h"
+#include "ADCachedFunc.h"
+#include "ADFastDiagonalization.h"
+#include "ADFlowReader.h"
+#include "ADGMRES.h"
+#include "ADGradientProjector.h"
+#include "ADMassInverse.h"
+#include "ADShmChannel.h"
+#include "ADTimeSeries.h"
+#include "SAM.h"
 #include "AnaSol.h"
 #include "Functions.h"
 #include "ExprFunctions.h"
@@ -29,7 +41,12 @@
 #include "Profiler.h"
 #include "Utilities.h"
 #include "DataExporter.h"
+#include "HDF5Writer.h"
 #include "tinyxml.h"
+#include "GoTools/geometry/SplineSurface.h"
+#include "GoTools/geometry/SplineVolume.h"
+#include <chrono>
+#include <memory>
 
 
 /*!
@@ -49,6 +66,7 @@ public:
     Integrand* integrand = nullptr; //!< Integrand to use
     SIMoutput* share = nullptr; //!< Simulator to share grid with
     bool standalone = false; //!< Simulator runs standalone
+    int refine = 0; //!< Number of uniform refinements of the input patches
   };
 
   //! \brief Default constructor.
@@ -56,7 +74,8 @@ public:
   //! \param[in] alone Integrand is used stand-alone (controls time stepping)
   explicit SIMAD(Integrand& ad, bool alone = false) :
     SIMMultiPatchModelGen<Dim>(1), AD(ad),
-    weakDirBC(Dim::dimension, 4.0, 1.0), inputContext("advectiondiffusion")
+    weakDirBC(Dim::dimension, 4.0, 1.0), projector(AD),
+    inputContext("advectiondiffusion")
   {
     standalone = alone;
     Dim::myProblem = &AD;
@@ -66,7 +85,8 @@ public:
   //! \brief Constructs from given properties.
   explicit SIMAD(const SetupProps& props) :
     SIMMultiPatchModelGen<Dim>(1), AD(*props.integrand),
-    weakDirBC(Dim::dimension, 4.0, 1.0), inputContext("advectiondiffusion")
+    weakDirBC(Dim::dimension, 4.0, 1.0), projector(AD),
+    inputContext("advectiondiffusion")
   {
     standalone = props.standalone;
     Dim::myProblem = &AD;
@@ -134,6 +154,11 @@ public:
         IFEM::cout <<"Reaction field: "<< value << std::endl;
       }
       else if ((value = utl::getValue(child,"source"))) {
+        if (AD.hasSource()) {
+          std::cerr <<" *** SIMAD::parse: Multiple source definitions."
+                    << std::endl;
+          return false;
+        }
         AD.setSource(new EvalFunction(value));
         IFEM::cout <<"Source field: "<< value << std::endl;
       }
@@ -156,12 +181,152 @@ public:
        utl::getAttribute(child,"max",maxSubIt);
        utl::getAttribute(child,"tol",subItTol);
       }
+      else if (strcasecmp(child->Value(),"history") == 0) {
+        std::string precision;
+        if (utl::getAttribute(child,"precision",precision,true))
+          floatHistory = precision == "float" || precision == "single";
+      }
+      else if (strcasecmp(child->Value(),"massinverse") == 0) {
+        if (!massInv.parse(child))
+          return false;
+      }
+      else if (strcasecmp(child->Value(),"flowfield") == 0) {
+        flowReader.reset(new ADFlowReader(child));
+        flowValid = false;
+        if (!flowReader->isValid())
+          return false;
+      }
+      else if (strcasecmp(child->Value(),"coupling") == 0) {
+        std::string type;
+        utl::getAttribute(child,"type",type,true);
+        if (type != "shm") {
+          std::cerr <<" *** SIMAD::parse: Invalid coupling type \""
+                    << type <<"\"."<< std::endl;
+          return false;
+        }
+        utl::getAttribute(child,"velocity",shmVelName);
+        utl::getAttribute(child,"temperature",shmTempName);
+        utl::getAttribute(child,"timeout",shmTimeout);
+        IFEM::cout <<"Shared memory coupling:";
+        if (!shmVelName.empty())
+          IFEM::cout <<" velocity from "<< shmVelName;
+        if (!shmTempName.empty())
+          IFEM::cout <<" temperature to "<< shmTempName;
+        IFEM::cout << std::endl;
+      }
+      else if (strcasecmp(child->Value(),"timeseries") == 0) {
+        if (!this->parseTimeSeries(child))
+          return false;
+      }
+      else if (strcasecmp(child->Value(),"denseoutput") == 0) {
+        utl::getAttribute(child,"interval",denseInterval);
+        IFEM::cout <<"Dense output every "<< denseInterval
+                   <<" time units."<< std::endl;
+      }
+      else if (strcasecmp(child->Value(),"bezier") == 0)
+        useBezier = true;
+      else if (strcasecmp(child->Value(),"warmstart") == 0) {
+        warmStart = true;
+        IFEM::cout <<"Warm starts of the adaptive cycles are enabled."
+                   << std::endl;
+      }
+      else if (strcasecmp(child->Value(),"matrixfree") == 0) {
+        mfTol = 1.0e-8;
+        utl::getAttribute(child,"tol",mfTol);
+        utl::getAttribute(child,"maxit",mfMaxIt);
+        utl::getAttribute(child,"restart",mfRestart);
+        utl::getAttribute(child,"update",mfUpdate);
+        std::string prec;
+        if (utl::getAttribute(child,"preconditioner",prec,true))
+          mfFDM = prec == "fdm";
+        if (!AD.setMatrixFree(AdvectionDiffusion::ASSEMBLED)) {
+          IFEM::cout <<"  ** Matrix-free solves are not supported by this"
+                     <<" integrand, ignored."<< std::endl;
+          mfTol = 0.0;
+          mfFDM = false;
+        }
+        else if (mfFDM)
+          IFEM::cout <<"Matrix-free GMRES: tolerance = "<< mfTol
+                     <<", fast diagonalization preconditioner."<< std::endl;
+        else
+          IFEM::cout <<"Matrix-free GMRES: tolerance = "<< mfTol
+                     <<", preconditioner update every "<< mfUpdate
+                     <<" steps."<< std::endl;
+      }
+      else if (strcasecmp(child->Value(),"pseudotransient") == 0) {
+        utl::getAttribute(child,"cfl",ptcCFL);
+        utl::getAttribute(child,"maxcfl",ptcMaxCFL);
+        utl::getAttribute(child,"tol",ptcTol);
+        utl::getAttribute(child,"maxit",ptcMaxIt);
+        IFEM::cout <<"Pseudo-transient continuation: CFL = "<< ptcCFL
+                   <<", max CFL = "<< ptcMaxCFL <<", tolerance = "<< ptcTol
+                   << std::endl;
+      }
       else
         this->Dim::parse(child);
 
     return true;
   }
 
+  //! \brief Parses a data-driven boundary condition or source term.
+  //! \param[in] elem The XML element with the time series definition
+  //!
+  //! \details The \a type attribute selects whether the series defines
+  //! a Dirichlet condition, a Neumann flux or the source term.
+  bool parseTimeSeries(const TiXmlElement* elem)
+  {
+    std::string type, set;
+    int comp = 1, code = 0;
+    utl::getAttribute(elem,"type",type,true);
+    utl::getAttribute(elem,"set",set);
+    utl::getAttribute(elem,"comp",comp);
+    utl::getAttribute(elem,"code",code);
+
+    Property::Type ptype = Property::UNDEFINED;
+    if (type == "dirichlet")
+      ptype = Property::DIRICHLET_INHOM;
+    else if (type == "neumann" || type == "flux")
+      ptype = Property::NEUMANN;
+    else if (type != "source") {
+      std::cerr <<" *** SIMAD::parse: Invalid time series type \""
+                << type <<"\"."<< std::endl;
+      return false;
+    }
+    else if (AD.hasSource()) {
+      std::cerr <<" *** SIMAD::parse: Multiple source definitions."
+                << std::endl;
+      return false;
+    }
+
+    ADTimeSeries* series = new ADTimeSeries(elem);
+    if (!series->isValid()) {
+      delete series;
+      return false;
+    }
+    timeSeries.push_back(series);
+
+    if (ptype == Property::UNDEFINED) {
+      IFEM::cout <<"Source field: time series"<< std::endl;
+      AD.setSource(series);
+      return true;
+    }
+
+    if (!set.empty())
+      code = this->getUniquePropertyCode(set,ptype == Property::NEUMANN ?
+                                         0 : comp);
+    if (code == 0) {
+      std::cerr <<" *** SIMAD::parse: No set or code given for time series."
+                << std::endl;
+      timeSeries.pop_back();
+      delete series;
+      return false;
+    }
+
+    this->setPropertyType(code,ptype);
+    Dim::myScalars[code] = series;
+    return true;
+  }
+
   //! \brief Returns the name of this simulator (for use in the HDF5 export).
   std::string getName() const override { return "AdvectionDiffusion"; }
 
@@ -174,12 +339,70 @@ public:
     AD.setOrder(p1); // assumes equal ordered basis
     AD.setElements(this->getNoElms());
 
-    // Initialize temperature solution vectors
-    this->initSolution(this->getNoDOFs(),3);
+    if (flowReader && this->getNoPatches() != 1) {
+      std::cerr <<" *** SIMAD::init: Stored flow fields are only supported"
+                <<" for single-patch models."<< std::endl;
+      return false;
+    }
+    if ((!shmVelName.empty() || !shmTempName.empty()) &&
+        this->getNoPatches() != 1) {
+      std::cerr <<" *** SIMAD::init: Shared memory coupling is only supported"
+                <<" for single-patch models."<< std::endl;
+      return false;
+    }
+
+    // The element kernels of the matrix-free solves only apply the interior
+    // operator, the weak Dirichlet terms would need their own kernels
+    if (mfTol > 0.0)
+      for (const Property& p : Dim::myProps)
+        if (p.pcode == Property::NEUMANN_GENERIC) {
+          std::cerr <<" *** SIMAD::init: Matrix-free solves are not supported"
+                    <<" with weak Dirichlet conditions."<< std::endl;
+          return false;
+        }
+
+    if (massInv.enabled() && !AD.hasMassSystem())
+      IFEM::cout <<"  ** The approximate mass inverse only applies to explicit"
+                 <<" time integration, ignored."<< std::endl;
+    else if (massInv.enabled() && AD.hasLocalMassInverse())
+      IFEM::cout <<"  ** The approximate mass inverse is not used with the"
+                 <<" discontinuous Galerkin formulation."<< std::endl;
+
+    // Initialize temperature solution vectors.
+    // The oldest level is optionally kept in single precision,
+    // which is only supported for single-patch models.
+    size_t nDoubles = 3;
+    oldSol.clear();
+    if (floatHistory && this->getNoPatches() == 1 &&
+        AD.setReducedHistory(&oldSol)) {
+      nDoubles = 2;
+      oldSol.resize(this->getNoDOFs());
+      IFEM::cout <<"Storing the oldest solution level in single precision."
+                 << std::endl;
+    }
+    else if (floatHistory)
+      IFEM::cout <<"  ** Single precision solution history is not supported"
+                 <<" for this model, using double precision."<< std::endl;
+
+    this->initSolution(this->getNoDOFs(),nDoubles);
     size_t n, nSols = this->getNoSolutions();
     std::string str = "temperature1";
     for (n = 0; n < nSols && n < 2; n++, str[11]++)
       this->registerField(str,solution[n]);
+
+    // The partner process creates the velocity segment and defines the
+    // session, which the temperature segment created here then carries
+    uint64_t session = ADShmChannel::newSession();
+    if (!shmVelName.empty()) {
+      if (!shmVel.attach(shmVelName,Dim::dimension*this->getNoNodes(),
+                         shmTimeout))
+        return false;
+      session = shmVel.getSession();
+    }
+    if (!shmTempName.empty() &&
+        !shmTemp.create(shmTempName,this->getNoDOFs(),session))
+      return false;
+
     return true;
   }
 
@@ -196,7 +419,59 @@ public:
   }
 
   //! \brief Defines the global number of elements.
-  bool preprocessB() override { AD.setElements(this->getNoElms());return true; }
+  //! \details Also resets the cached Dirichlet classification,
+  //! since the constrained nodes may have changed.
+  bool preprocessB() override
+  {
+    if ((AD.getIntegrandType() & Integrand::INTERFACE_TERMS) &&
+        !this->isDiscontinuous()) {
+      std::cerr <<" *** SIMAD::preprocessB: The discontinuous Galerkin"
+                <<" formulation requires a single axis-parallel box patch"
+                <<" with equal orders, uniform knot spans and C^-1 continuity"
+                <<" across all element interfaces."<< std::endl;
+      return false;
+    }
+
+    AD.setElements(this->getNoElms());
+    dirichletState = -1;
+    projector.clear();
+    massInv.clear();
+
+    // Element tables for the constant-coefficient terms
+    if (useBezier) {
+      std::vector<std::vector<double>> knots;
+      std::vector<int> order;
+      std::vector<double> length;
+      if (this->getTensorBasis(knots,order,length) &&
+          bezier.init(knots,order,length) &&
+          bezier.getNoElms() == this->getNoElms()) {
+        AD.setBezierExtraction(&bezier);
+        IFEM::cout <<"Bezier extraction assembly: "<< bezier.getNoElms()
+                   <<" elements in "<< bezier.getNoClasses()
+                   <<" congruence classes."<< std::endl;
+      }
+      else {
+        std::cerr <<"  ** SIMAD::preprocessB: Bezier extraction requires a"
+                  <<" single-patch affine box model, using quadrature."
+                  << std::endl;
+        AD.setBezierExtraction(nullptr);
+      }
+    }
+
+    // The solution of the previous mesh, as transferred by the refinement,
+    // is the initial guess. It is only worthwhile for iterative solvers.
+    if (warmStart && Dim::opt.solver != LinAlg::PETSC &&
+        Dim::opt.solver != LinAlg::ISTL) {
+      IFEM::cout <<"  ** Warm starts require an iterative linear solver,"
+                 <<" ignored."<< std::endl;
+      warmStart = false;
+    }
+    if (warmStart && warmSol.size() == this->getNoDOFs())
+      initialGuess.swap(warmSol);
+    warmSol.clear();
+
+    return true;
+  }
 
   //! \brief Opens a new VTF-file and writes the model geometry to it.
   //! \param[in] fileName File name used to construct the VTF-file name from
@@ -210,13 +485,86 @@ public:
   }
 
   //! \brief Advances the time step one step forward.
-  bool advanceStep(TimeStep&)
+  bool advanceStep(TimeStep& tp)
   {
-    this->pushSolution(); // Update solution vectors between time steps
+    this->rotateSolution(); // Update solution vectors between time steps
     AD.advanceStep();
+
+    // The explicit drivers advance the current level in place, so keep the
+    // start of the step for the dense output
+    if (denseInterval > 0.0 && AD.hasMassSystem()) {
+      denseU0 = solution.front();
+      denseT0 = tp.time.t - tp.time.dt;
+      denseRates = false;
+    }
+
+    // Copy the time series samples of the step, for lock-free evaluation
+    for (ADTimeSeries* series : timeSeries)
+      if (!series->setTimeInterval(tp.time.t-tp.time.dt,tp.time.t+tp.time.dt))
+        return false;
+
+    return true;
+  }
+
+  //! \brief Returns the full state of the time stepping.
+  //! \param[out] state All solution history levels, one after the other
+  //! \details Used to restart the time stepping from a given state, with the
+  //! history that the multistep schemes depend on.
+  void getState(Vector& state) const
+  {
+    state.clear();
+    for (const Vector& s : solution)
+      state.insert(state.end(),s.begin(),s.end());
+    state.insert(state.end(),oldSol.begin(),oldSol.end());
+  }
+
+  //! \brief Restores the full state of the time stepping.
+  //! \param[in] state All solution history levels, as given by getState()
+  bool setState(const Vector& state)
+  {
+    size_t size = oldSol.size();
+    for (const Vector& s : solution)
+      size += s.size();
+    if (state.size() != size) {
+      std::cerr <<" *** SIMAD::setState: Invalid state size "<< state.size()
+                <<" != "<< size << std::endl;
+      return false;
+    }
+
+    Vector::const_iterator it = state.begin();
+    for (Vector& s : solution) {
+      std::copy(it,it+s.size(),s.begin());
+      it += s.size();
+    }
+    std::copy(it,state.end(),oldSol.begin());
+    solTimes.clear();
     return true;
   }
 
+  //! \brief Shifts the solution history one level back.
+  //! \details Unlike SIMsolution::pushSolution(), the history levels are
+  //! rotated as a ring buffer by swapping the vector storage. The vector
+  //! objects stay in place, so registered fields, the primary solution binding
+  //! and serialization all see the levels in the usual order. Only the current
+  //! solution is copied, as start value for the next step.
+  void rotateSolution()
+  {
+    size_t nSols = solution.size();
+    if (nSols < 2) return;
+
+    if (!oldSol.empty())
+      std::copy(solution.back().begin(),solution.back().end(),oldSol.begin());
+
+    for (size_t n = nSols-1; n > 0; n--)
+      solution[n].swap(solution[n-1]);
+    solution.front() = solution[1];
+
+    if (Dim::msgLevel > 1 && nSols > 2)
+      IFEM::cout <<"  Solution history rotated, saved "
+                 << 2*(nSols-2)*solution.front().size()*sizeof(double)
+                 <<" bytes of memory traffic"<< std::endl;
+  }
+
   //! \brief Computes the solution for the current time step.
   bool solveStep(TimeStep& tp, bool = false)
   {
@@ -226,13 +574,30 @@ public:
     if (Dim::msgLevel >= 0 && standalone && tp.multiSteps())
       IFEM::cout <<"\n  step = "<< tp.step <<"  time = "<< tp.time.t << std::endl;
 
-    Vector dummy;
-    this->updateDirichlet(tp.time.t,&dummy);
+    this->updateDirichletData(tp.time.t);
+
+    if (flowReader && tp.multiSteps() && !this->updateFlowField(tp.time))
+      return false;
+
+    if (shmVel.isOpen() && !this->receiveVelocity(tp))
+      return false;
 
-    if (!this->assembleSystem(tp.time,solution))
+    if (ptcCFL > 0.0 && !tp.multiSteps()) {
+      if (!this->solvePseudoTransient(tp.time))
+        return false;
+    }
+    else if (mfTol > 0.0 && tp.multiSteps()) {
+      if (!this->solveMatrixFree(tp))
+        return false;
+    }
+    else if (!this->assembleSystem(tp.time,solution))
+      return false;
+    else if (!this->solveSystem(solution.front(),Dim::msgLevel-1,"temperature "))
       return false;
 
-    if (!this->solveSystem(solution.front(),Dim::msgLevel-1,"temperature "))
+    if (shmVel.isOpen())
+      shmVel.acknowledge(tp.step);
+    if (shmTemp.isOpen() && !this->sendTemperature(tp))
       return false;
 
     if (Dim::msgLevel == 1)
@@ -251,6 +616,723 @@ public:
     return true;
   }
 
+  //! \brief Updates the inhomogeneous Dirichlet conditions.
+  //! \param[in] t Current time
+  //!
+  //! \details The Dirichlet functions are classified as constant or
+  //! time-dependent on the first call after preprocessing. When all of them
+  //! are constant in time, the boundary values are only evaluated once.
+  //! Otherwise, the constant scalar functions are replaced by caching
+  //! wrappers, such that only the time-dependent ones are re-evaluated at
+  //! the boundary nodes in each step.
+  bool updateDirichletData(double t)
+  {
+    if (dirichletState < 0) {
+      dirichletState = 0;
+      for (const Property& p : Dim::myProps)
+        if (p.pcode == Property::DIRICHLET_INHOM) {
+          typename Dim::SclFuncMap::iterator sit;
+          typename Dim::VecFuncMap::const_iterator vit;
+          bool timeDep = false;
+          if ((sit = Dim::myScalars.find(p.pindx)) != Dim::myScalars.end()) {
+            timeDep = !sit->second->isConstant();
+            if (!timeDep && !dynamic_cast<ADCachedFunc*>(sit->second))
+              sit->second = new ADCachedFunc(sit->second);
+          }
+          else if ((vit = Dim::myVectors.find(p.pindx)) != Dim::myVectors.end())
+            timeDep = !vit->second->isConstant();
+          if (timeDep)
+            dirichletState = 2;
+          if (Dim::msgLevel > 1)
+            IFEM::cout <<"  Dirichlet code "<< p.pindx <<" is "
+                       << (timeDep ? "time-dependent" : "constant")
+                       << std::endl;
+        }
+    }
+    else if (dirichletState == 1)
+      return true; // constant in time and already evaluated
+
+    Vector dummy;
+    if (!this->updateDirichlet(t,&dummy))
+      return false;
+
+    if (dirichletState == 0)
+      dirichletState = 1;
+    return true;
+  }
+
+  //! \brief Updates the advecting velocity from the stored flow field.
+  //! \param[in] time Time domain of the current step
+  //!
+  //! \details The registered vectors \a velocity1 and \a velocity2 receive
+  //! the stored velocity interpolated at the two previous time levels,
+  //! as they would from a coupled flow solver. The level of the previous
+  //! step is reused, so only one interpolation is needed per step.
+  bool updateFlowField(const TimeDomain& time)
+  {
+    Vector* u1 = AD.getNamedVector("velocity1");
+    Vector* u2 = AD.getNamedVector("velocity2");
+    if (!u1 || !u2) {
+      std::cerr <<" *** SIMAD::updateFlowField: The integrand does not"
+                <<" support a stored flow field."<< std::endl;
+      return false;
+    }
+
+    // Reuse the previous level only if it is the level needed now
+    double tn = time.t - time.dt;
+    if (flowValid && fabs(flowTime - (tn-time.dt)) <= 1.0e-12*time.dt)
+      u2->swap(*u1);
+    else if (!flowReader->interpolate(tn-time.dt,*u2))
+      return false;
+
+    if (!flowReader->interpolate(tn,*u1))
+      return false;
+
+    size_t nval = Dim::dimension*this->getNoNodes();
+    if (u1->size() != nval) {
+      std::cerr <<" *** SIMAD::updateFlowField: Stored flow field has "
+                << u1->size() <<" values, expected "<< nval << std::endl;
+      return false;
+    }
+
+    flowTime = tn;
+    flowValid = true;
+    if (Dim::msgLevel > 1)
+      IFEM::cout <<"  Stored flow field at t = "<< tn <<", frames read"
+                 <<" synchronously: "<< flowReader->getStalls() << std::endl;
+
+    return true;
+  }
+
+  //! \brief Receives the advecting velocity from the coupled process.
+  //! \param[in] tp Time stepping parameters
+  //!
+  //! \details The integrand reads the velocity of the current and the
+  //! previous step directly from the shared memory segment.
+  bool receiveVelocity(const TimeStep& tp)
+  {
+    const int step = tp.step;
+    const double* u1 = shmVel.read(step,shmTimeout);
+    if (!u1) {
+      std::cerr <<" *** SIMAD::receiveVelocity: Timed out waiting for step "
+                << step <<", or the partner closed the segment."<< std::endl;
+      return false;
+    }
+
+    // The partner must advance with the same time steps
+    double t1 = shmVel.time(step);
+    if (fabs(t1 - tp.time.t) > 1.0e-12*std::max(tp.time.dt,1.0)) {
+      std::cerr <<" *** SIMAD::receiveVelocity: Step "<< step <<" has time "
+                << t1 <<" in the shared memory segment, expected "
+                << tp.time.t << std::endl;
+      return false;
+    }
+
+    const double* u2 = step > 1 ? shmVel.slot(step-1) : u1;
+    if (!AD.setExternalVelocity(u1,u2,shmVel.size())) {
+      std::cerr <<" *** SIMAD::receiveVelocity: The integrand does not"
+                <<" support external velocities."<< std::endl;
+      return false;
+    }
+
+    return true;
+  }
+
+  //! \brief Sends the temperature to the coupled process.
+  //! \param[in] tp Time stepping parameters
+  bool sendTemperature(const TimeStep& tp)
+  {
+    double* T = shmTemp.beginWrite(tp.step,shmTimeout);
+    if (!T) {
+      std::cerr <<" *** SIMAD::sendTemperature: Timed out waiting for the"
+                <<" partner to read step "<< tp.step-1 << std::endl;
+      return false;
+    }
+
+    std::copy(solution.front().begin(),solution.front().end(),T);
+    shmTemp.endWrite(tp.step,tp.time.t);
+    return true;
+  }
+
+  //! \brief Sets an initial guess for the next stationary solve.
+  //! \param[in] u0 Nodal temperature, typically prolonged from a coarser level
+  void setInitialGuess(const Vector& u0)
+  {
+    if (u0.size() == this->getNoDOFs())
+      initialGuess = u0;
+    else
+      std::cerr <<"  ** SIMAD::setInitialGuess: Size mismatch "<< u0.size()
+                <<" != "<< this->getNoDOFs() <<", ignored."<< std::endl;
+  }
+
+  //! \brief Prolongs a solution of a coarser model to this model.
+  //! \param[in] coarse The coarser model, with the same patches before
+  //! uniform refinement
+  //! \param[in] uc Nodal solution of the coarser model
+  //! \param[out] u Nodal solution on this model
+  //!
+  //! \details The coarse field is interpolated at the Greville points of
+  //! each refined patch. Since the refined spline space contains the coarse
+  //! one, the interpolant is the coarse field itself, i.e., the result equals
+  //! knot insertion.
+  bool prolong(const SIMAD<Dim,Integrand>& coarse, const Vector& uc,
+               Vector& u) const
+  {
+    if (coarse.getNoPatches() != this->getNoPatches()) {
+      std::cerr <<" *** SIMAD::prolong: The models have "
+                << coarse.getNoPatches() <<" and "<< this->getNoPatches()
+                <<" patches."<< std::endl;
+      return false;
+    }
+
+    u.resize(this->getNoDOFs(),true);
+    Vector locC, locF;
+    for (size_t i = 0; i < Dim::myModel.size(); i++) {
+      const ASMbase* pch = coarse.getFEModel()[i];
+      coarse.extractPatchSolution(uc,locC,pch);
+      if (!Dim::myModel[i]->evaluate(pch,locC,locF,1))
+        return false;
+      Dim::myModel[i]->injectNodeVec(locF,u);
+    }
+
+    return true;
+  }
+
+  //! \brief Extracts the values of the free equations from a nodal vector.
+  //! \param[in] u Nodal values
+  //! \param[out] x Values in equation ordering
+  void scatterFree(const Vector& u, SystemVector& x) const
+  {
+    IntVec meen;
+    Real* xp = x.getPtr();
+    size_t nnod = this->getNoNodes();
+    size_t ndof = nnod > 0 ? u.size() / nnod : 0;
+    for (size_t n = 1; n <= nnod; n++)
+      if (this->getSAM()->getNodeEqns(meen,n))
+        for (size_t j = 0; j < meen.size() && j < ndof; j++)
+          if (meen[j] > 0)
+            xp[meen[j]-1] = u[ndof*(n-1)+j];
+  }
+
+  //! \brief Solves the assembled stationary system in defect correction form.
+  //! \details The linear solver computes the correction to the initial guess
+  //! from the residual of the guess. The work vectors are of the type of the
+  //! linear solver, such that the residual is computed by its own backend.
+  //! Note that a linear solver with a relative tolerance does not need fewer
+  //! iterations with a better guess. It reduces the residual of the guess by
+  //! the same factor, which gives a more accurate solution instead.
+  //! \param[out] u The solution vector
+  //! \param[in] printSol Print solution if its size is less than \a printSol
+  //! \param[in] compName Solution name to be used in norm output
+  //! \param[out] resNorm Residual norm of the initial guess
+  bool solveCorrection(Vector& u, int printSol, const char* compName,
+                       double* resNorm = nullptr)
+  {
+    const SAM* sam = this->getSAM();
+    const SystemMatrix* A = this->getLHSmatrix();
+    SystemVector* b = this->getRHSvector();
+    if (!sam || !A || !b)
+      return false;
+
+    // Scatter the initial guess to the free equations
+    std::unique_ptr<SystemVector> x(SystemVector::create(&Dim::adm,
+                                                         Dim::opt.solver));
+    std::unique_ptr<SystemVector> Ax(SystemVector::create(&Dim::adm,
+                                                          Dim::opt.solver));
+    if (!x || !Ax)
+      return false;
+    x->redim(b->dim());
+    Ax->redim(b->dim());
+    this->scatterFree(initialGuess,*x);
+
+    // Replace the right-hand-side by the residual of the guess
+    double bNorm = b->norm2();
+    if (!A->multiply(*x,*Ax))
+      return false;
+    b->add(*Ax,-1.0);
+    if (resNorm)
+      *resNorm = b->norm2();
+    else
+      IFEM::cout <<"  Residual of initial guess: "<< b->norm2()
+                 <<" (relative "<< (bNorm > 0.0 ? b->norm2()/bNorm : 0.0)
+                 <<")"<< std::endl;
+
+    Vector dx;
+    if (!this->Dim::solveSystem(dx,printSol,nullptr,compName))
+      return false;
+
+    // Add the correction of the free equations and expand
+    Ax->init();
+    this->scatterFree(dx,*Ax);
+    x->add(*Ax);
+
+    initialGuess.clear();
+    return sam->expandSolution(*x,u);
+  }
+
+  //! \brief Solves a time step with a matrix-free Krylov method.
+  //! \param[in] tp Time stepping parameters
+  //!
+  //! \details The operator is applied by element kernels, assembling only
+  //! the vector of the element matrices times the element values. The
+  //! system matrix is assembled and solved directly on the first step and
+  //! then every \a mfUpdate steps. In the steps between, the factorized
+  //! (or otherwise preconditioned) matrix of the last assembly is used as
+  //! preconditioner for GMRES. This saves the assembly and factorization
+  //! when the velocity changes between the steps.
+  //!
+  //! With the fast diagonalization preconditioner, the system matrix is
+  //! never assembled. GMRES is then preconditioned by the exact inverse of
+  //! the mass and diffusion part of the operator, and handles the advection.
+  bool solveMatrixFree(const TimeStep& tp)
+  {
+    // Assemble and solve directly when updating the preconditioner
+    bool update = !mfFDM &&
+                  (mfSteps == 0 || (mfUpdate > 0 && mfSteps % mfUpdate == 0));
+    ++mfSteps;
+    if (update)
+      return this->assembleSystem(tp.time,solution) &&
+             this->solveSystem(solution.front(),Dim::msgLevel-1,"temperature ");
+
+    const SAM* sam = this->getSAM();
+    SystemMatrix* P = this->getLHSmatrix();
+    SystemVector* b = this->getRHSvector();
+    if (!sam || (!P && !mfFDM) || !b)
+      return false;
+
+    // Initial guess with the current Dirichlet values
+    StdVector x0(b->dim());
+    this->scatterFree(solution.front(),x0);
+    if (!sam->expandSolution(x0,solution.front()))
+      return false;
+
+    // Residual of the initial guess
+    this->setMode(SIM::RHS_ONLY);
+    AD.setMatrixFree(AdvectionDiffusion::RESIDUAL);
+    bool ok = this->assembleSystem(tp.time,solution,false);
+    StdVector r(b->getRef(),b->dim());
+
+    Vectors work(solution);
+    ADGMRES::Operator A = [this,sam,b,&tp,&work](const Vector& v, Vector& y)
+    {
+      StdVector z(v.data(),v.size());
+      if (!sam->expandSolution(z,work.front(),0.0) ||
+          !this->assembleSystem(tp.time,work,false))
+        return false;
+      y.resize(b->dim());
+      std::copy(b->getRef(),b->getRef()+b->dim(),y.begin());
+      return true;
+    };
+    ADGMRES::Operator M = [P](const Vector& v, Vector& y)
+    {
+      StdVector z(v.data(),v.size());
+      if (!P->solve(z))
+        return false;
+      y = z;
+      return true;
+    };
+
+    double sigma, kappa;
+    if (mfFDM && AD.getOperatorCoefficients(tp.time.dt,sigma,kappa)) {
+      fdm.setCoefficients(sigma,kappa);
+      M = [this,sam](const Vector& v, Vector& y)
+      {
+        StdVector z(v.data(),v.size());
+        Vector u, w;
+        if (!sam->expandSolution(z,u,0.0) || !fdm.apply(u,w))
+          return false;
+        StdVector x(v.size());
+        this->scatterFree(w,x);
+        y = x;
+        return true;
+      };
+    }
+
+    ADGMRES gmres(mfTol,mfMaxIt,mfRestart);
+    StdVector dx(b->dim());
+    AD.setMatrixFree(AdvectionDiffusion::OPERATOR);
+    ok = ok && gmres.solve(A,M,r,dx);
+    AD.setMatrixFree(AdvectionDiffusion::ASSEMBLED);
+    this->setMode(SIM::DYNAMIC);
+    if (!ok)
+      return false;
+
+    if (Dim::msgLevel > 0)
+      IFEM::cout <<"  Matrix-free GMRES: "<< gmres.getIterations()
+                 <<" iterations, relative residual "<< gmres.getResidual()
+                 << std::endl;
+    // Fall back to the assembled solve, which also refreshes the
+    // preconditioner, rather than accepting an unconverged step
+    if (!gmres.converged() && mfFDM) {
+      std::cerr <<" *** SIMAD::solveMatrixFree: GMRES did not converge,"
+                <<" relative residual "<< gmres.getResidual()
+                <<". There is no system matrix to fall back to with the"
+                <<" fast diagonalization preconditioner."<< std::endl;
+      return false;
+    }
+    else if (!gmres.converged()) {
+      std::cerr <<"  ** SIMAD::solveMatrixFree: GMRES did not converge,"
+                <<" relative residual "<< gmres.getResidual()
+                <<", solving the assembled system."<< std::endl;
+      mfSteps = 1;
+      return this->assembleSystem(tp.time,solution) &&
+             this->solveSystem(solution.front(),Dim::msgLevel-1,"temperature ");
+    }
+
+    x0.add(dx);
+    return sam->expandSolution(x0,solution.front());
+  }
+
+  //! \brief Returns \e true if the model is a conforming broken mesh.
+  //! \details The local inverse mass matrices of the discontinuous Galerkin
+  //! formulation are only valid if no basis function is shared between
+  //! elements, i.e., if each interior knot is repeated \a order times.
+  //! The neighbour traces are evaluated by mirroring the element basis, which
+  //! in addition requires a single affine box patch with equal orders and
+  //! uniform knot spans, such that all elements are congruent.
+  bool isDiscontinuous() const
+  {
+    std::vector<std::vector<double>> knots;
+    std::vector<int> order;
+    std::vector<double> length;
+    if (!this->getTensorBasis(knots,order,length))
+      return false;
+
+    for (size_t d = 0; d < knots.size(); d++) {
+      if (order[d] != order.front())
+        return false;
+
+      // Distinct knot values and their multiplicities
+      std::vector<double> u;
+      std::vector<int> mult;
+      for (double t : knots[d])
+        if (u.empty() || t > u.back()) {
+          u.push_back(t);
+          mult.push_back(1);
+        }
+        else
+          mult.back()++;
+
+      for (size_t i = 1; i+1 < u.size(); i++)
+        if (mult[i] < order[d])
+          return false;
+
+      double h = u[1] - u[0];
+      for (size_t i = 2; i < u.size(); i++)
+        if (fabs(u[i]-u[i-1]-h) > 1.0e-8*h)
+          return false;
+    }
+
+    return true;
+  }
+
+  //! \brief Returns the tensor-product basis of a single-patch box model.
+  //! \param[out] knots Knot vector in each parameter direction
+  //! \param[out] order Spline order in each direction
+  //! \param[out] length Physical length of the box in each direction
+  //! \details Fails unless the model is a single spline patch with one
+  //! unknown per node, whose control points are at the Greville points of
+  //! an axis-parallel box, i.e., the geometry mapping is affine. Rational
+  //! patches are rejected, since their basis functions are not B-splines.
+  bool getTensorBasis(std::vector<std::vector<double>>& knots,
+                      std::vector<int>& order,
+                      std::vector<double>& length) const
+  {
+    knots.clear();
+    order.clear();
+    if (this->getNoPatches() != 1 || this->getNoFields() != 1)
+      return false;
+
+    Go::BoundingBox box;
+    const ASMbase* pch = this->getPatch(1);
+    const ASMs2D* pch2 = dynamic_cast<const ASMs2D*>(pch);
+    const ASMs3D* pch3 = dynamic_cast<const ASMs3D*>(pch);
+    if (pch2 && pch2->getSurface()) {
+      const Go::SplineSurface* srf = pch2->getSurface();
+      if (srf->rational())
+        return false;
+      knots.emplace_back(srf->basis_u().begin(),srf->basis_u().end());
+      knots.emplace_back(srf->basis_v().begin(),srf->basis_v().end());
+      order = { srf->order_u(), srf->order_v() };
+      box = srf->boundingBox();
+    }
+    else if (pch3 && pch3->getVolume()) {
+      const Go::SplineVolume* vol = pch3->getVolume();
+      if (vol->rational())
+        return false;
+      for (int d = 0; d < 3; d++) {
+        knots.emplace_back(vol->basis(d).begin(),vol->basis(d).end());
+        order.push_back(vol->order(d));
+      }
+      box = vol->boundingBox();
+    }
+    else
+      return false;
+
+    length.resize(knots.size());
+    size_t nn[3] = { 1, 1, 1 };
+    for (size_t d = 0; d < knots.size(); d++) {
+      length[d] = box.high()[d] - box.low()[d];
+      nn[d] = knots[d].size() - order[d];
+    }
+    if (nn[0]*nn[1]*nn[2] != this->getNoNodes())
+      return false;
+
+    // Check that the control points are at the mapped Greville points
+    for (size_t n = 0; n < this->getNoNodes(); n++) {
+      size_t ijk[3] = { n % nn[0], (n/nn[0]) % nn[1], n/(nn[0]*nn[1]) };
+      Vec3 X = this->getNodeCoord(n+1);
+      for (size_t d = 0; d < knots.size(); d++) {
+        const std::vector<double>& t = knots[d];
+        const int p = order[d] - 1;
+        double xi = 0.0;
+        for (int k = 1; k <= p; k++)
+          xi += t[ijk[d]+k];
+        xi = p > 0 ? xi/p : t[ijk[d]];
+        double t0 = t[p], t1 = t[nn[d]];
+        double x = box.low()[d] + length[d]*(xi - t0)/(t1 - t0);
+        if (fabs(X[d] - x) > 1.0e-8*length[d])
+          return false;
+      }
+    }
+
+    return true;
+  }
+
+  //! \brief Sets up the fast diagonalization preconditioner.
+  //! \details Faces where all nodes are constrained are treated as
+  //! homogeneous Dirichlet boundaries.
+  bool initFastDiagonalization()
+  {
+    std::vector<std::vector<double>> knots;
+    std::vector<int> order;
+    std::vector<double> length;
+    if (!this->getTensorBasis(knots,order,length))
+      return false;
+
+    size_t nn[3] = { 1, 1, 1 };
+    for (size_t d = 0; d < knots.size(); d++)
+      nn[d] = knots[d].size() - order[d];
+
+    // A boundary is free if any of its nodes has a free equation
+    std::vector<std::pair<bool,bool>> fixed(knots.size(),{true,true});
+    IntVec meen;
+    for (size_t n = 0; n < this->getNoNodes(); n++) {
+      if (!this->getSAM()->getNodeEqns(meen,n+1) ||
+          meen.empty() || meen.front() <= 0)
+        continue;
+      size_t ijk[3] = { n % nn[0], (n/nn[0]) % nn[1], n/(nn[0]*nn[1]) };
+      for (size_t d = 0; d < knots.size(); d++) {
+        if (ijk[d] == 0)
+          fixed[d].first = false;
+        if (ijk[d]+1 == nn[d])
+          fixed[d].second = false;
+      }
+    }
+
+    if (!fdm.init(knots,order,length,fixed))
+      return false;
+
+    IFEM::cout <<"Fast diagonalization preconditioner:";
+    for (size_t d = 0; d < knots.size(); d++)
+      IFEM::cout <<" "<< nn[d];
+    IFEM::cout <<" nodes."<< std::endl;
+    return true;
+  }
+
+  //! \brief Initializes the linear equation system.
+  //! \details With the fast diagonalization preconditioner of the matrix-free
+  //! solves, the system matrix is never used. Only the right-hand-side vector
+  //! is then allocated.
+  bool initLinearSystem()
+  {
+    if (mfFDM && !this->initFastDiagonalization()) {
+      IFEM::cout <<"  ** Fast diagonalization is not applicable, using the"
+                 <<" assembled preconditioner."<< std::endl;
+      mfFDM = false;
+    }
+
+    if (mfFDM)
+      return this->initSystem(Dim::opt.solver,0,1);
+
+    return this->initSystem(Dim::opt.solver);
+  }
+
+  //! \brief Solves the stationary problem by pseudo-transient continuation.
+  //! \param[in] time Time domain of the stationary problem
+  //!
+  //! \details Each iteration solves for a pseudo time step from the current
+  //! iterate, with the local time steps of the integrand. Since the pseudo
+  //! time derivative vanishes at the current iterate, the residual of the
+  //! iterate in the assembled system is the stationary residual. The CFL
+  //! number grows inversely proportional to this residual (switched
+  //! evolution relaxation), such that the iterations approach Newton steps
+  //! as the solution converges.
+  bool solvePseudoTransient(const TimeDomain& time)
+  {
+    double cfl = ptcCFL, res0 = 0.0;
+    bool converged = false;
+    for (int it = 1; it <= ptcMaxIt && !converged; it++) {
+      AD.setPseudoTimeStep(cfl);
+      this->setMode(SIM::STATIC);
+      initialGuess = solution.front();
+      double res = 0.0;
+      if (!this->assembleSystem(time,solution) ||
+          !this->solveCorrection(solution.front(),Dim::msgLevel-2,
+                                 "temperature ",&res))
+        break;
+
+      if (it == 1)
+        res0 = res > 0.0 ? res : 1.0;
+      IFEM::cout <<"  Pseudo time iteration "<< it <<": residual = "<< res
+                 <<", CFL = "<< cfl << std::endl;
+      converged = res <= ptcTol*res0;
+      if (res > 0.0)
+        cfl = std::min(ptcMaxCFL,ptcCFL*res0/res);
+    }
+
+    AD.setPseudoTimeStep(0.0);
+    this->setMode(SIM::STATIC);
+    initialGuess.clear();
+    if (!converged)
+      std::cerr <<" *** SIMAD::solvePseudoTransient: No convergence in "
+                << ptcMaxIt <<" iterations."<< std::endl;
+
+    return converged;
+  }
+
+  using Dim::solveSystem;
+  //! \brief Solves the assembled linear system of equations.
+  //! \details Uses the initial guess, if any, in defect correction form.
+  //! With warm starts enabled, the solution is kept, such that the solve
+  //! after the next mesh refinement starts from it.
+  //!
+  //! With the discontinuous Galerkin formulation the assembled right-hand
+  //! side is the solution, since the inverse mass is applied element by
+  //! element during the assembly.
+  //!
+  //! If enabled, the consistent mass matrix of the explicit time integration
+  //! is inverted approximately by a fixed number of lumped-preconditioned
+  //! iterations instead of the linear equation solver. Since all explicit
+  //! drivers solve their stages through this method, this also applies to
+  //! the Runge-Kutta drivers of the core library.
+  bool solveSystem(Vector& u, int printSol, double* rCond,
+                   const char* compName, size_t idxRHS) override
+  {
+    bool ok;
+    if (AD.hasLocalMassInverse() && idxRHS == 0) {
+      // The element right-hand sides are already premultiplied by the
+      // inverse element mass matrices, so there is nothing to solve
+      const SystemVector* b = this->getRHSvector();
+      ok = b && this->getSAM()->expandSolution(*b,u);
+    }
+    else if (massInv.enabled() && AD.hasMassSystem() && idxRHS == 0) {
+      const SystemMatrix* M = this->getLHSmatrix();
+      const SystemVector* b = this->getRHSvector();
+      StdVector x;
+      ok = M && b && massInv.apply(*M,*b,x) &&
+           this->getSAM()->expandSolution(x,u);
+    }
+    else if (!initialGuess.empty() && idxRHS == 0 && warmStart) {
+      auto start = std::chrono::steady_clock::now();
+      ok = this->solveCorrection(u,printSol,compName);
+      std::chrono::duration<double> used = std::chrono::steady_clock::now()-start;
+      IFEM::cout <<"Warm start: solved from the transferred solution in "
+                 << used.count() <<" s."<< std::endl;
+    }
+    else if (!initialGuess.empty() && idxRHS == 0)
+      ok = this->solveCorrection(u,printSol,compName);
+    else
+      ok = this->Dim::solveSystem(u,printSol,rCond,compName,idxRHS);
+
+    if (ok && warmStart)
+      warmSol = u;
+
+    return ok;
+  }
+
+  using Dim::refine;
+  //! \brief Refines a list of elements and transfers solution vectors.
+  //! \param[in] prm Input data used to control the refinement
+  //! \param sol Vectors to transfer to the refined mesh
+  //! \param[in] fName Optional mesh output file (Encapsulated PostScript)
+  //!
+  //! \details With warm starts enabled, the last solution is transferred
+  //! along with the other vectors. Since the refined spline space contains
+  //! the old one, the transfer is exact.
+  bool refine(const LR::RefineData& prm, Vectors& sol,
+              const char* fName) override
+  {
+    if (!warmStart || warmSol.empty() || this->getNoPatches() != 1)
+      return this->Dim::refine(prm,sol,fName);
+
+    utl::profiler->start("Warm start transfer");
+    auto start = std::chrono::steady_clock::now();
+    sol.push_back(warmSol);
+    bool ok = this->Dim::refine(prm,sol,fName);
+    if (ok)
+      warmSol.swap(sol.back());
+    else
+      warmSol.clear();
+    sol.pop_back();
+    utl::profiler->stop("Warm start transfer");
+
+    std::chrono::duration<double> used = std::chrono::steady_clock::now()-start;
+    IFEM::cout <<"Warm start: transferred "<< warmSol.size()
+               <<" values to the refined mesh in "<< used.count() <<" s."
+               << std::endl;
+    return ok;
+  }
+
+  using Dim::assembleSystem;
+  //! \brief Administers assembly of the linear equation system.
+  //! \param[in] time Parameters for nonlinear/time-dependent simulations
+  //! \param[in] prevSol Previous primary solution vectors in DOF-order
+  //! \param[in] newLHSmatrix If \e false, only integrate the RHS vector
+  //! \param[in] poorConvg If \e true, the nonlinear driver is converging poorly
+  //!
+  //! \details With the approximate mass inverse, the mass matrix of the
+  //! explicit time integration does not change between the stages. It is then
+  //! only assembled once for each mesh, and later stages only assemble the
+  //! right-hand side. Models with inhomogeneous Dirichlet conditions are
+  //! excluded, since the lifting of the boundary values needs the element
+  //! matrices.
+  bool assembleSystem(const TimeDomain& time, const Vectors& prevSol,
+                      bool newLHSmatrix = true, bool poorConvg = false) override
+  {
+    bool inhomDir = false;
+    for (const Property& p : Dim::myProps)
+      if (p.pcode == Property::DIRICHLET_INHOM)
+        inhomDir = true;
+
+    if (!newLHSmatrix || !massInv.initialized() || inhomDir ||
+        !AD.hasMassSystem() || AD.hasLocalMassInverse())
+      return this->Dim::assembleSystem(time,prevSol,newLHSmatrix,poorConvg);
+
+    this->setMode(SIM::RHS_ONLY);
+    bool ok = this->Dim::assembleSystem(time,prevSol,false,poorConvg);
+    this->setMode(SIM::DYNAMIC);
+    return ok;
+  }
+
+  //! \brief Evaluates the time derivative of the temperature field.
+  //! \param[out] dudt The time derivative (mass matrix inverse times residual)
+  //! \param[in] u The temperature state to evaluate the derivative for
+  //! \param[in] time Time domain of the evaluation
+  //!
+  //! \details Used by the explicit time integration drivers of this
+  //! application.
+  bool evalTimeDerivative(Vector& dudt, const Vector& u,
+                          const TimeDomain& time)
+  {
+    this->updateDirichletData(time.t);
+
+    if (!this->assembleSystem(time,Vectors(1,u)))
+      return false;
+
+    return this->solveSystem(dudt,Dim::msgLevel-2,"temperature rate ");
+  }
+
   //! \brief No solution postprocessing.
   bool postSolve(const TimeStep&) { return true; }
 
@@ -285,6 +1367,9 @@ public:
   {
     PROFILE1("SIMAD::saveStep");
 
+    if (denseInterval > 0.0 && tp.multiSteps())
+      return this->saveDenseOutput(tp,nBlock);
+
     if (tp.step%Dim::opt.saveInc > 0 || Dim::opt.format < 0)
       return true;
 
@@ -298,10 +1383,183 @@ public:
     return this->writeGlvStep(iDump,tp.time.t);
   }
 
+  //! \brief Saves the solution at the output times within the last step.
+  //! \param[in] tp Time step identifier
+  //! \param[out] nBlock Running VTF block counter
+  //!
+  //! \details The output times are the multiples of the dense output
+  //! interval. The solution is interpolated at each of them, such that the
+  //! step size is independent of the output times. Every \a saveInc frame
+  //! is written.
+  bool saveDenseOutput(const TimeStep& tp, int& nBlock)
+  {
+    // Record the time of the current solution level
+    if (solTimes.empty() && tp.step > 0)
+      solTimes.push_back(tp.time.t - tp.time.dt);
+    if (solTimes.empty() || solTimes.front() != tp.time.t)
+      solTimes.insert(solTimes.begin(),tp.time.t);
+    if (solTimes.size() > solution.size() + (oldSol.empty() ? 0 : 1))
+      solTimes.pop_back();
+
+    // The explicit drivers interpolate by the cubic Hermite polynomial,
+    // from the solution and its time derivative at both ends of the step
+    double t0 = solTimes.back();
+    if (AD.hasMassSystem() && tp.step > 0) {
+      TimeDomain time(tp.time);
+      time.t = t0 = denseT0;
+      if (!denseRates) {
+        if (denseF1.size() == denseU0.size() && denseT1 == denseT0)
+          denseF0.swap(denseF1);
+        else if (!this->evalTimeDerivative(denseF0,denseU0,time))
+          return false;
+        time.t = tp.time.t;
+        if (!this->evalTimeDerivative(denseF1,solution.front(),time))
+          return false;
+      }
+      denseT1 = tp.time.t;
+    }
+
+    const double eps = 1.0e-10*denseInterval;
+    double kFirst = ceil((t0-eps)/denseInterval);
+    long int k = static_cast<long int>(kFirst);
+    if (nDense > 0)
+      k = std::max(k,lastDense+1);
+    for (; k*denseInterval <= tp.time.t+eps; k++) {
+      double tOut = k*denseInterval;
+      if (!AD.hasMassSystem())
+        this->interpolateSolution(tOut,denseSol);
+      else if (tp.step > 0)
+        SIMAD::interpolateHermite((tOut-t0)/(tp.time.t-t0),tp.time.t-t0,
+                                  denseU0,denseF0,solution.front(),denseF1,
+                                  denseSol);
+      else
+        denseSol = solution.front();
+      if (!this->saveDenseFrame(tOut,nBlock))
+        return false;
+      lastDense = k;
+    }
+
+    return true;
+  }
+
+  //! \brief Writes a dense output frame, subject to the save increment.
+  //! \param[in] t The time of the frame
+  //! \param[out] nBlock Running VTF block counter
+  //!
+  //! \details The interpolated solution in \a denseSol is written to the
+  //! VTF-file and, if enabled by handleDenseOutput(), to the HDF5-file.
+  bool saveDenseFrame(double t, int& nBlock)
+  {
+    int frame = nDense++;
+    if (frame%Dim::opt.saveInc > 0)
+      return true;
+
+    int iDump = 1 + frame/Dim::opt.saveInc;
+    if (Dim::opt.format >= 0) {
+      if (!this->writeGlvS1(denseSol,iDump,nBlock,t,"temperature",89))
+        return false;
+      else if (standalone && !this->writeGlvStep(iDump,t))
+        return false;
+    }
+
+    if (!denseExporter)
+      return true;
+
+    TimeStep tOut;
+    tOut.step = frame;
+    tOut.time.t = t;
+    return denseExporter->dumpTimeLevel(&tOut);
+  }
+
+  //! \brief Evaluates the cubic Hermite interpolant over a time step.
+  //! \param[in] theta Relative position within the step
+  //! \param[in] h The step size
+  //! \param[in] u0 The solution at the start of the step
+  //! \param[in] f0 The time derivative at the start of the step
+  //! \param[in] u1 The solution at the end of the step
+  //! \param[in] f1 The time derivative at the end of the step
+  //! \param[out] u The interpolated solution
+  static void interpolateHermite(double theta, double h,
+                                 const Vector& u0, const Vector& f0,
+                                 const Vector& u1, const Vector& f1,
+                                 Vector& u)
+  {
+    double t2 = theta*theta, t3 = t2*theta;
+    u = u0;
+    u *= 2.0*t3 - 3.0*t2 + 1.0;
+    u.add(f0,h*(t3 - 2.0*t2 + theta));
+    u.add(u1,3.0*t2 - 2.0*t3);
+    u.add(f1,h*(t3 - t2));
+  }
+
+  //! \brief Sets the time derivatives at both ends of the last step.
+  //! \param[in] f0 The time derivative at the start of the step
+  //! \param[in] f1 The time derivative at the end of the step
+  //! \details Used by drivers which have evaluated them anyway, such that
+  //! the dense output does not need to evaluate them again.
+  void setStepRates(const Vector& f0, const Vector& f1)
+  {
+    if (denseInterval <= 0.0)
+      return;
+
+    denseF0 = f0;
+    denseF1 = f1;
+    denseRates = true;
+  }
+
+  //! \brief Enables HDF5 output of the dense output frames.
+  //! \param[in] hdf5file The HDF5-file to write to
+  //! \details Replaces the output of the time steps by the solver, since
+  //! the frames are at the dense output times instead.
+  void handleDenseOutput(const std::string& hdf5file)
+  {
+    denseExporter.reset(new DataExporter(true,Dim::opt.saveInc));
+    denseExporter->registerWriter(new HDF5Writer(hdf5file,
+                                                 this->getProcessAdm()));
+    this->registerFields(*denseExporter);
+  }
+
+  //! \brief Returns \e true if dense output is enabled.
+  bool hasDenseOutput() const { return denseInterval > 0.0; }
+  //! \brief Returns the number of dense output frames.
+  int getNoDenseFrames() const { return nDense; }
+  //! \brief Returns the solution of the last dense output frame.
+  const Vector& getDenseSolution() const { return denseSol; }
+
+  //! \brief Interpolates the solution in time.
+  //! \param[in] t The time to interpolate at
+  //! \param[out] u The interpolated solution
+  //!
+  //! \details Uses the Lagrange polynomial through the stored solution
+  //! levels, which is quadratic once three levels are available. This is
+  //! the interpolant underlying the BDF2 scheme.
+  void interpolateSolution(double t, Vector& u) const
+  {
+    size_t nLev = solTimes.size();
+    u.resize(solution.front().size(),true);
+    for (size_t i = 0; i < nLev; i++) {
+      double w = 1.0;
+      for (size_t j = 0; j < nLev; j++)
+        if (j != i)
+          w *= (t - solTimes[j]) / (solTimes[i] - solTimes[j]);
+
+      if (i < solution.size())
+        u.add(solution[i],w);
+      else
+        for (size_t k = 0; k < u.size(); k++)
+          u[k] += w*oldSol[k];
+    }
+  }
+
   //! \brief Serialize internal state for restarting purposes.
   //! \param data Container for serialized data
   bool serialize(SerializeMap& data) const override
   {
+    if (!oldSol.empty())
+      data[this->getName()+"::history"] =
+        std::string(reinterpret_cast<const char*>(oldSol.data()),
+                    oldSol.size()*sizeof(float));
+
     return this->saveSolution(data,this->getName());
   }
 
@@ -312,6 +1570,14 @@ public:
     if (!this->restoreSolution(data,this->getName()))
       return false;
 
+    if (!oldSol.empty()) {
+      SerializeMap::const_iterator it = data.find(this->getName()+"::history");
+      if (it == data.end() || it->second.size() != oldSol.size()*sizeof(float))
+        return false;
+      std::copy(it->second.begin(),it->second.end(),
+                reinterpret_cast<char*>(oldSol.data()));
+    }
+
     AD.advanceStep();
     return true;
   }
@@ -341,7 +1607,8 @@ public:
 
     exporter.registerField("u","temperature",DataExporter::SIM,
                            results, prefix);
-    exporter.setFieldValue("u", this, &this->getSolution(0));
+    exporter.setFieldValue("u", this, denseInterval > 0.0 ? &denseSol
+                                                          : &this->getSolution(0));
   }
 
   //! \brief Set context to read from input file
@@ -373,6 +1640,32 @@ public:
   void setCommunicator(const MPI_Comm* comm) { Dim::adm.setCommunicator(comm); }
 #endif
 
+  using Dim::project;
+  //! \brief Projects the secondary solution associated with a primary solution.
+  //! \param[out] ssol Control point values of the secondary solution
+  //! \param[in] psol Control point values of the primary solution
+  //! \param[in] pMethod Projection method to use
+  //! \param[in] time Parameters for nonlinear and time-dependent simulations
+  //!
+  //! \details Continuous global L2 projections are done with a projection
+  //! matrix that is factorized once for each mesh and then reused.
+  //! This is only done in serial runs, since the matrix is assembled over the
+  //! global node numbers, and not for LR-spline models, whose mesh is changed
+  //! by each adaptive cycle such that the factorization is never reused.
+  //! All other projection methods are done by the library as selected.
+  bool project(Matrix& ssol, const Vector& psol,
+               SIMoptions::ProjectionMethod pMethod,
+               const TimeDomain& time) const override
+  {
+    bool cached = Dim::adm.getNoProcs() == 1 &&
+                  Dim::opt.discretization != ASM::LRSpline;
+    if (cached && pMethod == SIMoptions::CGL2)
+      if (projector.project(ssol,psol,Dim::myModel,this->getNoNodes(),time))
+        return true;
+
+    return this->Dim::project(ssol,psol,pMethod,time);
+  }
+
   //! \brief Sets the externally provided solution vector (adaptive simulation).
   void setSol(const Vector* sol) { extsol = sol; }
 
@@ -432,8 +1725,53 @@ protected:
 private:
   Integrand& AD; //!< Problem integrand definition
   AdvectionDiffusion::WeakDirichlet weakDirBC; //!< Weak Dirichlet integrand
+  mutable ADGradientProjector projector; //!< Cached gradient projection
+  ADMassInverse massInv; //!< Approximate consistent mass inverse
+  std::vector<ADTimeSeries*> timeSeries; //!< Time series functions (not owned)
+  std::unique_ptr<ADFlowReader> flowReader; //!< Stored flow field reader
+  double flowTime = 0.0; //!< Time level of the stored velocity in velocity1
+  bool flowValid = false; //!< If \e true, \a flowTime is valid
+  Vector initialGuess; //!< Initial guess for the next stationary solve
+  bool warmStart = false; //!< If \e true, start from the previous solution
+  std::vector<double> solTimes; //!< Times of the solution levels
+  double denseInterval = 0.0; //!< Dense output interval (0: not used)
+  int nDense = 0; //!< Number of dense output frames written
+  long int lastDense = 0; //!< Interval index of the last dense output frame
+  Vector denseSol; //!< Solution of the last dense output frame
+  Vector denseU0;  //!< Solution at the start of the last explicit step
+  Vector denseF0;  //!< Time derivative at the start of the last explicit step
+  Vector denseF1;  //!< Time derivative at the end of the last explicit step
+  double denseT0 = 0.0; //!< Start time of the last explicit step
+  double denseT1 = -1.0; //!< Time level of \a denseF1
+  bool denseRates = false; //!< If \e true, the driver has set the rates
+  std::unique_ptr<DataExporter> denseExporter; //!< Dense output HDF5 export
+  double mfTol = 0.0; //!< Matrix-free GMRES tolerance (0: not used)
+  int mfMaxIt = 200; //!< Maximum number of matrix-free GMRES iterations
+  int mfRestart = 30; //!< Number of GMRES iterations between restarts
+  int mfUpdate = 10; //!< Steps between preconditioner assemblies
+  int mfSteps = 0; //!< Number of matrix-free time steps
+  bool mfFDM = false; //!< Use fast diagonalization as preconditioner
+  ADFastDiagonalization fdm; //!< Fast diagonalization preconditioner
+
+  bool useBezier = false; //!< Use Bezier extraction for element matrices
+  ADBezierExtraction bezier; //!< Bezier extraction tables
+  double ptcCFL = 0.0; //!< Initial pseudo time CFL number (0: not used)
+  double ptcMaxCFL = 1.0e8; //!< Maximum pseudo time CFL number
+  double ptcTol = 1.0e-8; //!< Relative residual tolerance of pseudo time
+  int ptcMaxIt = 100; //!< Maximum number of pseudo time iterations
+  Vector warmSol; //!< Previous solution, for warm starts
+  ADShmChannel shmVel;    //!< Shared memory channel for received velocity
+  ADShmChannel shmTemp;   //!< Shared memory channel for sent temperature
+  std::string shmVelName;  //!< Name of the velocity segment
+  std::string shmTempName; //!< Name of the temperature segment
+  double shmTimeout = 60.0; //!< Coupling timeout in seconds
 
   const Vector* extsol = nullptr; //!< Solution vector for adaptive simulators
+  std::vector<float> oldSol; //!< Oldest solution level in single precision
+  bool floatHistory = false; //!< If \e true, store oldest level as float
+  //! Dirichlet state (-1: unclassified, 0: constant, 1: constant and
+  //! evaluated, 2: time-dependent)
+  int dirichletState = -1;
   bool standalone = false; //!< If \e true, this simulator owns the VTF object
   std::string inputContext; //!< Input context
   double subItTol = 1e-4; //!< Sub-iteration tolerance
@@ -464,13 +1802,20 @@ struct SolverConfigurator< SIMAD<Dim,Integrand> > {
 
     utl::profiler->stop("Model input");
 
+    // Uniformly refine the patches for a nested iteration level
+    if (props.refine > 0)
+      for (ASMbase* pch : ad.getFEModel())
+        for (unsigned short int d = 0; d < Dim::dimension; d++)
+          if (!pch->uniformRefine(d,(1 << props.refine)-1))
+            return 2;
+
     // Preprocess the model and establish data structures for the algebraic system
     if (!ad.preprocess())
       return 3;
 
     // Initialize the linear solvers
     ad.setMode(SIM::DYNAMIC);
-    ad.initSystem(ad.opt.solver);
+    ad.initLinearSystem();
     ad.setQuadratureRule(ad.opt.nGauss[0]);
 
     // Time-step loop
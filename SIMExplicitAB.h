@@ -0,0 +1,182 @@
+// $Id$
+//==============================================================================
+//!
+//! \file SIMExplicitAB.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Explicit Adams-Bashforth(-Moulton) multistep time integration driver.
+//!
+//==============================================================================
+
+#ifndef _SIM_EXPLICIT_AB_H
+#define _SIM_EXPLICIT_AB_H
+
+#include "SIMExplicitRK.h"
+#include "TimeStep.h"
+#include "IFEM.h"
+#include "Profiler.h"
+#include <cmath>
+
+
+/*!
+  \brief Explicit Adams-Bashforth multistep driver.
+
+  \details The time derivatives of the previous steps are stored, such that
+  a step of the plain Adams-Bashforth scheme (AB2 or AB3) costs a single
+  operator evaluation. With the predictor-corrector option, the
+  Adams-Bashforth prediction is corrected by the Adams-Moulton scheme of the
+  same order (PECE), at the cost of one more evaluation per step.
+
+  The history is started by Runge-Kutta steps of the same order, and it is
+  restarted whenever the step size changes or the state is restored from a
+  restart file.
+
+  The solver class must provide the method evalTimeDerivative(), see SIMAD.
+*/
+
+template<class Solver>
+class SIMExplicitAB : public TimeIntegration::SIMExplicitRK<Solver>
+{
+public:
+  //! \brief The constructor initializes the scheme parameters.
+  //! \param solv The simulator to do time stepping for
+  //! \param[in] ord Order of the scheme (2 or 3)
+  //! \param[in] corrector If \e true, use an Adams-Moulton corrector
+  SIMExplicitAB(Solver& solv, int ord, bool corrector) :
+    TimeIntegration::SIMExplicitRK<Solver>(solv,TimeIntegration::EULER),
+    model(solv), order(ord == 3 ? 3 : 2), PECE(corrector), hist(order)
+  {
+  }
+
+  //! \brief Empty destructor.
+  virtual ~SIMExplicitAB() {}
+
+  //! \brief Solves for the next time step.
+  //! \param tp Time stepping parameters
+  bool solveStep(TimeStep& tp)
+  {
+    PROFILE1("SIMExplicitAB::solveStep");
+
+    const double dt = tp.time.dt;
+    const double t0 = tp.time.t - dt;
+    Vector& u = model.getSolution();
+
+    // Restart the history if the step size has changed
+    if (nHist > 0 && fabs(dt-histDt) > 1.0e-12*dt)
+      nHist = 0;
+    histDt = dt;
+
+    // Shift the history and evaluate the derivative at the current state
+    for (int i = order-1; i > 0; i--)
+      hist[i].swap(hist[i-1]);
+    nHist = std::min(nHist+1,order);
+
+    TimeDomain time(tp.time);
+    time.t = t0;
+    if (!model.evalTimeDerivative(hist.front(),u,time))
+      return false;
+    ++nEval;
+
+    if (nHist < order) {
+      if (Solver::msgLevel > 0)
+        IFEM::cout <<"  Runge-Kutta start-up step "<< nHist << std::endl;
+      return this->startupStep(u,time,dt);
+    }
+
+    // Adams-Bashforth predictor
+    static const double ab[2][3] = {{ 1.5, -0.5, 0.0 },
+                                    { 23.0/12.0, -16.0/12.0, 5.0/12.0 }};
+    const Vector un(u);
+    for (int i = 0; i < order; i++)
+      u.add(hist[i],dt*ab[order-2][i]);
+
+    if (PECE) {
+      // Adams-Moulton corrector
+      static const double am[2][3] = {{ 0.5, 0.5, 0.0 },
+                                      { 5.0/12.0, 8.0/12.0, -1.0/12.0 }};
+      Vector fp;
+      time.t = t0 + dt;
+      if (!model.evalTimeDerivative(fp,u,time))
+        return false;
+      ++nEval;
+
+      u = un;
+      u.add(fp,dt*am[order-2][0]);
+      for (int i = 1; i < order; i++)
+        u.add(hist[i-1],dt*am[order-2][i]);
+    }
+
+    if (Solver::msgLevel > 0)
+      IFEM::cout <<"  Adams-Bashforth"<< (PECE ? "-Moulton " : " ") << order
+                 <<" step, operator evaluations "<< nEval << std::endl;
+
+    return true;
+  }
+
+  //! \brief Discards the history, e.g., when the solution is reset.
+  void reset() { nHist = 0; }
+
+  //! \brief Sets internal state from a serialized state.
+  //! \details The history is not serialized, it is restarted instead.
+  template<class T> bool deSerialize(const T& data)
+  {
+    nHist = 0;
+    return model.deSerialize(data);
+  }
+
+protected:
+  //! \brief Performs a Runge-Kutta step to start up the history.
+  //! \param u The solution to advance
+  //! \param[in] time Time domain at the start of the step
+  //! \param[in] dt Time step size
+  //!
+  //! \details Uses Heun's method for AB2 and Kutta's third order method for
+  //! AB3. The first stage is the already evaluated history entry.
+  bool startupStep(Vector& u, const TimeDomain& time, double dt)
+  {
+    TimeDomain stage(time);
+    const Vector un(u);
+    Vector k2, k3, tmp(un);
+    if (order == 2) {
+      tmp.add(hist.front(),dt);
+      stage.t = time.t + dt;
+      if (!model.evalTimeDerivative(k2,tmp,stage))
+        return false;
+      nEval++;
+      u.add(hist.front(),0.5*dt);
+      u.add(k2,0.5*dt);
+    }
+    else {
+      tmp.add(hist.front(),0.5*dt);
+      stage.t = time.t + 0.5*dt;
+      if (!model.evalTimeDerivative(k2,tmp,stage))
+        return false;
+      tmp = un;
+      tmp.add(hist.front(),-dt);
+      tmp.add(k2,2.0*dt);
+      stage.t = time.t + dt;
+      if (!model.evalTimeDerivative(k3,tmp,stage))
+        return false;
+      nEval += 2;
+      u.add(hist.front(),dt/6.0);
+      u.add(k2,4.0*dt/6.0);
+      u.add(k3,dt/6.0);
+    }
+
+    return true;
+  }
+
+  Solver& model; //!< Reference to the simulator
+  int  order;    //!< Order of the scheme
+  bool PECE;     //!< If \e true, use the Adams-Moulton corrector
+
+  Vectors hist;         //!< Time derivatives of the current and previous steps
+  int     nHist = 0;    //!< Number of valid entries in \a hist
+  double  histDt = 0.0; //!< Step size of the history
+  size_t  nEval = 0;    //!< Number of operator evaluations
+};
+
+#endif
@@ -0,0 +1,218 @@
+// $Id$
+//==============================================================================
+//!
+//! \file SIMExplicitFSAL.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Embedded first-same-as-last Runge-Kutta time integration driver.
+//!
+//==============================================================================
+
+#ifndef _SIM_EXPLICIT_FSAL_H
+#define _SIM_EXPLICIT_FSAL_H
+
+#include "SIMExplicitRK.h"
+#include "TimeStep.h"
+#include "IFEM.h"
+#include "Profiler.h"
+#include <cmath>
+
+
+/*!
+  \brief Explicit embedded Runge-Kutta driver for first-same-as-last pairs.
+
+  \details The last stage of an accepted step equals the first stage of the
+  next step, so each accepted step costs one operator evaluation less than a
+  regular embedded pair. When a step is rejected, the first stage is still
+  valid and is reused for the retry. The step size is selected by a PI
+  controller.
+
+  The first and last stages are the time derivatives at both ends of the
+  step. They are handed to the simulator for the dense output.
+
+  The solver class must provide the methods evalTimeDerivative() and
+  setStepRates(), see SIMAD.
+*/
+
+template<class Solver>
+class SIMExplicitFSAL : public TimeIntegration::SIMExplicitRK<Solver>
+{
+public:
+  //! \brief Enum defining the available Runge-Kutta pairs.
+  enum Pair {
+    BS32 = 1, //!< Bogacki-Shampine 3(2)
+    DP54 = 2  //!< Dormand-Prince 5(4)
+  };
+
+  //! \brief The constructor sets up the Butcher tableau.
+  //! \param solv The simulator to do time stepping for
+  //! \param[in] pair The Runge-Kutta pair to use
+  //! \param[in] tol Error tolerance for the step size selection
+  SIMExplicitFSAL(Solver& solv, int pair, double tol) :
+    TimeIntegration::SIMExplicitRK<Solver>(solv,TimeIntegration::EULER),
+    model(solv), errTol(tol)
+  {
+    if (pair == DP54) {
+      order = 5;
+      c = { 0.0, 0.2, 0.3, 0.8, 8.0/9.0, 1.0, 1.0 };
+      A.resize(7,7);
+      A(2,1) = 0.2;
+      A(3,1) = 3.0/40.0;
+      A(3,2) = 9.0/40.0;
+      A(4,1) = 44.0/45.0;
+      A(4,2) = -56.0/15.0;
+      A(4,3) = 32.0/9.0;
+      A(5,1) = 19372.0/6561.0;
+      A(5,2) = -25360.0/2187.0;
+      A(5,3) = 64448.0/6561.0;
+      A(5,4) = -212.0/729.0;
+      A(6,1) = 9017.0/3168.0;
+      A(6,2) = -355.0/33.0;
+      A(6,3) = 46732.0/5247.0;
+      A(6,4) = 49.0/176.0;
+      A(6,5) = -5103.0/18656.0;
+      b = { 35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0,
+            -2187.0/6784.0, 11.0/84.0, 0.0 };
+      bhat = { 5179.0/57600.0, 0.0, 7571.0/16695.0, 393.0/640.0,
+               -92097.0/339200.0, 187.0/2100.0, 1.0/40.0 };
+    }
+    else {
+      order = 3;
+      c = { 0.0, 0.5, 0.75, 1.0 };
+      A.resize(4,4);
+      A(2,1) = 0.5;
+      A(3,2) = 0.75;
+      b = { 2.0/9.0, 1.0/3.0, 4.0/9.0, 0.0 };
+      bhat = { 7.0/24.0, 0.25, 1.0/3.0, 0.125 };
+    }
+
+    // The last stage is evaluated at the new solution
+    for (size_t j = 1; j < c.size(); j++)
+      A(c.size(),j) = b[j-1];
+  }
+
+  //! \brief Empty destructor.
+  virtual ~SIMExplicitFSAL() {}
+
+  //! \brief Solves for the next time step, with step size control.
+  //! \param tp Time stepping parameters
+  bool solveStep(TimeStep& tp)
+  {
+    PROFILE1("SIMExplicitFSAL::solveStep");
+
+    const size_t nStage = c.size();
+    const double t0 = tp.time.t - tp.time.dt;
+    const Vector un(model.getSolution());
+
+    Vectors k(nStage);
+    bool haveFirst = haveLast && fabs(lastTime-t0) <= 1.0e-12*tp.time.dt;
+    if (haveFirst)
+      k.front().swap(kLast);
+    haveLast = false;
+
+    TimeDomain time(tp.time);
+    Vector unew;
+    for (int iter = 0;; iter++) {
+      double dt = tp.time.dt;
+      for (size_t i = 0; i < nStage; i++) {
+        if (i == 0 && haveFirst) {
+          ++nReused;
+          continue;
+        }
+        Vector tmp(un);
+        for (size_t j = 0; j < i; j++)
+          if (A(i+1,j+1) != 0.0)
+            tmp.add(k[j],dt*A(i+1,j+1));
+        time.t = t0 + c[i]*dt;
+        time.dt = dt;
+        if (!model.evalTimeDerivative(k[i],tmp,time))
+          return false;
+        if (i+1 == nStage)
+          unew.swap(tmp);
+        ++nEval;
+      }
+      haveFirst = true;
+
+      // Estimate the error using the embedded solution
+      double err = 0.0;
+      for (size_t n = 0; n < un.size(); n++) {
+        double e = 0.0;
+        for (size_t i = 0; i < nStage; i++)
+          e += (b[i]-bhat[i])*k[i][n];
+        double sc = errTol*(1.0 + std::max(fabs(un[n]),fabs(unew[n])));
+        err += pow(dt*e/sc,2.0);
+      }
+      err = un.empty() ? 0.0 : sqrt(err/un.size());
+
+      // PI step size controller
+      const double alpha = 0.7/order, beta = 0.4/order;
+      double fac = err > 0.0 ? 0.9*pow(err,-alpha)*pow(errOld,beta) : 5.0;
+      fac = std::min(5.0,std::max(0.2,fac));
+
+      if (err <= 1.0 || iter >= maxRetry) {
+        if (err > 1.0)
+          IFEM::cout <<"  ** SIMExplicitFSAL: Accepting step with error "
+                     << err <<" after "<< iter <<" retries."<< std::endl;
+        model.getSolution() = unew;
+        model.setStepRates(k.front(),k.back());
+        kLast.swap(k.back());
+        haveLast = true;
+        lastTime = t0 + dt;
+        errOld = std::max(err,1.0e-4);
+        tp.time.dt = dt*fac;
+        if (Solver::msgLevel > 0)
+          IFEM::cout <<"  Accepted step dt = "<< dt <<" error = "<< err
+                     <<" next dt = "<< tp.time.dt
+                     <<"\n  Operator evaluations "<< nEval
+                     <<", saved by stage reuse "<< nReused << std::endl;
+        return true;
+      }
+
+      // Rejected step, retry with a smaller step reusing the first stage
+      tp.time.dt = dt*std::min(1.0,fac);
+      tp.time.t = t0 + tp.time.dt;
+      if (Solver::msgLevel > 0)
+        IFEM::cout <<"  Rejected step dt = "<< dt <<" error = "<< err
+                   <<", retrying with dt = "<< tp.time.dt << std::endl;
+    }
+  }
+
+  //! \brief Discards the reused stage and the step size control history.
+  void reset()
+  {
+    haveLast = false;
+    errOld = 1.0;
+  }
+
+  //! \brief Sets internal state from a serialized state.
+  //! \details The reused stage is not serialized, it is recomputed.
+  template<class T> bool deSerialize(const T& data)
+  {
+    haveLast = false;
+    return model.deSerialize(data);
+  }
+
+protected:
+  Solver& model; //!< Reference to the simulator
+
+  std::vector<double> c;    //!< Stage times
+  std::vector<double> b;    //!< Weights of the propagated solution
+  std::vector<double> bhat; //!< Weights of the embedded solution
+  Matrix A;                 //!< Stage coefficients
+  int    order;             //!< Order of the propagated solution
+  double errTol;            //!< Error tolerance
+
+  Vector kLast;           //!< Last stage of the previous step
+  bool   haveLast = false; //!< True if \a kLast is valid
+  double lastTime = 0.0;   //!< Time level of \a kLast
+  double errOld = 1.0;     //!< Error estimate of the previous accepted step
+  int    maxRetry = 10;    //!< Maximum number of retries of a step
+
+  size_t nEval = 0;   //!< Number of operator evaluations
+  size_t nReused = 0; //!< Number of operator evaluations saved by reuse
+};
+
+#endif
@@ -0,0 +1,205 @@
+// $Id$
+//==============================================================================
+//!
+//! \file SIMExplicitRKC.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Runge-Kutta-Chebyshev stabilized explicit time integration driver.
+//!
+//==============================================================================
+
+#ifndef _SIM_EXPLICIT_RKC_H
+#define _SIM_EXPLICIT_RKC_H
+
+#include "SIMExplicitRK.h"
+#include "TimeStep.h"
+#include "IFEM.h"
+#include "Profiler.h"
+#include <cmath>
+
+
+/*!
+  \brief Second order Runge-Kutta-Chebyshev (RKC) driver.
+
+  \details The number of stages is chosen each step from an estimate of the
+  spectral radius of the semi-discrete operator, such that the stability
+  interval of the damped Chebyshev polynomial covers the step. This allows
+  time steps far above the explicit limit for diffusion dominated problems,
+  using only a few solution sized vectors and no implicit solves beyond the
+  mass matrix.
+
+  The spectral radius is estimated by power iterations on the difference
+  of two operator evaluations. It is computed on the first step and then
+  every \a nUpdate steps.
+
+  The solver class must provide the method evalTimeDerivative(), see SIMAD.
+*/
+
+template<class Solver>
+class SIMExplicitRKC : public TimeIntegration::SIMExplicitRK<Solver>
+{
+public:
+  //! \brief The constructor initializes the scheme parameters.
+  //! \param solv The simulator to do time stepping for
+  //! \param[in] update Number of steps between spectral radius estimates
+  //! (0 means estimate on the first step only)
+  SIMExplicitRKC(Solver& solv, int update = 0) :
+    TimeIntegration::SIMExplicitRK<Solver>(solv,TimeIntegration::EULER),
+    model(solv), nUpdate(update)
+  {
+  }
+
+  //! \brief Empty destructor.
+  virtual ~SIMExplicitRKC() {}
+
+  //! \brief Discards the spectral radius estimate and the step count.
+  void reset()
+  {
+    rho = 0.0;
+    nSteps = 0;
+  }
+
+  //! \brief Solves for the next time step.
+  //! \param tp Time stepping parameters
+  bool solveStep(TimeStep& tp)
+  {
+    PROFILE1("SIMExplicitRKC::solveStep");
+
+    const double dt = tp.time.dt;
+    const double t0 = tp.time.t - dt;
+    Vector& u = model.getSolution();
+
+    TimeDomain time(tp.time);
+    time.t = t0;
+
+    Vector F0;
+    if (!model.evalTimeDerivative(F0,u,time))
+      return false;
+
+    if (rho <= 0.0 || (nUpdate > 0 && nSteps % nUpdate == 0))
+      if (!this->estimateSpectralRadius(u,F0,time))
+        return false;
+    ++nSteps;
+
+    // Number of stages needed to cover the step, with 20% safety
+    const int s = std::max(2,1+static_cast<int>(sqrt(1.0+1.54*1.2*dt*rho)));
+
+    // Chebyshev polynomials and their derivatives at w0
+    const double w0 = 1.0 + damping/(s*s);
+    std::vector<double> T(s+1), dT(s+1), d2T(s+1);
+    T[0] = 1.0; T[1] = w0;
+    dT[0] = 0.0; dT[1] = 1.0;
+    d2T[0] = d2T[1] = 0.0;
+    for (int j = 2; j <= s; j++) {
+      T[j]   = 2.0*w0*T[j-1] - T[j-2];
+      dT[j]  = 2.0*T[j-1] + 2.0*w0*dT[j-1] - dT[j-2];
+      d2T[j] = 4.0*dT[j-1] + 2.0*w0*d2T[j-1] - d2T[j-2];
+    }
+    const double w1 = dT[s]/d2T[s];
+
+    std::vector<double> b(s+1), c(s+1);
+    for (int j = 2; j <= s; j++) {
+      b[j] = d2T[j]/(dT[j]*dT[j]);
+      c[j] = w1*d2T[j]/dT[j];
+    }
+    b[0] = b[1] = b[2];
+    c[0] = 0.0;
+    c[1] = c[2]/dT[2];
+
+    // First stage
+    const Vector Y0(u);
+    Vector Yjm2(Y0), Yjm1(Y0), Fj;
+    Yjm1.add(F0,b[1]*w1*dt);
+
+    // Remaining stages, three-term recursion
+    for (int j = 2; j <= s; j++) {
+      double mu  = 2.0*b[j]*w0/b[j-1];
+      double nu  = -b[j]/b[j-2];
+      double mut = 2.0*b[j]*w1/b[j-1];
+      double gt  = -(1.0 - b[j-1]*T[j-1])*mut;
+
+      time.t = t0 + c[j-1]*dt;
+      if (!model.evalTimeDerivative(Fj,Yjm1,time))
+        return false;
+
+      u = Y0;
+      u *= 1.0 - mu - nu;
+      u.add(Yjm1,mu);
+      u.add(Yjm2,nu);
+      u.add(Fj,mut*dt);
+      u.add(F0,gt*dt);
+
+      Yjm2.swap(Yjm1);
+      Yjm1 = u;
+    }
+
+    if (Solver::msgLevel > 0)
+      IFEM::cout <<"  RKC step with "<< s <<" stages, spectral radius "<< rho
+                 << std::endl;
+
+    return true;
+  }
+
+  //! \brief Sets internal state from a serialized state.
+  //! \details Forces a new spectral radius estimate.
+  template<class T> bool deSerialize(const T& data)
+  {
+    rho = 0.0;
+    return model.deSerialize(data);
+  }
+
+protected:
+  //! \brief Estimates the spectral radius of the semi-discrete operator.
+  //! \param[in] u Current solution
+  //! \param[in] F0 Time derivative at the current solution
+  //! \param[in] time Current time domain
+  bool estimateSpectralRadius(const Vector& u, const Vector& F0,
+                              const TimeDomain& time)
+  {
+    // Start from a perturbation of the current solution
+    Vector v(u), Fv;
+    double unorm = u.norm2();
+    double eps = 1.0e-7*(unorm > 0.0 ? unorm : 1.0);
+    for (size_t i = 0; i < v.size(); i++)
+      v[i] = i % 2 ? 1.0 : -1.0;
+    v *= eps/v.norm2();
+
+    double lambda = 0.0;
+    for (int it = 0; it < maxIt; it++) {
+      Vector w(u);
+      w += v;
+      if (!model.evalTimeDerivative(Fv,w,time))
+        return false;
+      Fv -= F0;
+
+      double vnorm = Fv.norm2();
+      if (vnorm <= 0.0)
+        break;
+      double lambdaOld = lambda;
+      lambda = vnorm/eps;
+      v = Fv;
+      v *= eps/vnorm;
+      if (fabs(lambda-lambdaOld) <= 0.01*lambda)
+        break;
+    }
+
+    rho = lambda;
+    if (Solver::msgLevel > 0)
+      IFEM::cout <<"  Estimated spectral radius: "<< rho << std::endl;
+
+    return true;
+  }
+
+  Solver& model; //!< Reference to the simulator
+
+  double damping = 2.0/13.0; //!< Damping parameter of the Chebyshev polynomial
+  double rho = 0.0;          //!< Estimated spectral radius
+  int    nUpdate;            //!< Number of steps between estimates
+  int    nSteps = 0;         //!< Number of steps taken
+  int    maxIt = 20;         //!< Maximum number of power iterations
+};
+
+#endif
@@ -0,0 +1,197 @@
+// $Id$
+//==============================================================================
+//!
+//! \file SIMPeriodicShooting.h
+//!
+//! \date Oct 19 2026
+//!
+//! \author agent / SINTEF
+//!
+//! \brief Newton-Krylov shooting for time-periodic steady states.
+//!
+//==============================================================================
+
+#ifndef _SIM_PERIODIC_SHOOTING_H
+#define _SIM_PERIODIC_SHOOTING_H
+
+#include "ADGMRES.h"
+#include "TimeStep.h"
+#include "IFEM.h"
+#include "Profiler.h"
+
+
+/*!
+  \brief Driver computing the periodic steady state of a forced problem.
+
+  \details The period map \f$P\f$ takes the solution at the start of a
+  period to the solution one period later, by the regular time stepping of
+  the simulator. The periodic state is the fixed point \f$u = P(u)\f$, which
+  is found by Newton iterations, where the Jacobian system
+  \f$(I - P'(u))\delta u = P(u) - u\f$ is solved by GMRES. Each product with
+  \f$P'(u)\f$ costs one period integration. Since the decay of the transient
+  usually leaves only a few slow modes in \f$P'\f$, GMRES converges in a few
+  iterations, compared to the many periods needed to reach the periodic
+  state by plain time stepping.
+
+  The state of the period map is the full solution history of the model,
+  such that the map of a multistep scheme is exact, and affine for the
+  linear problem. One period is integrated from the initial condition
+  before the Newton iterations, such that the startup steps of lower order
+  are done, and all later period integrations use the same scheme.
+
+  The stepper class must provide advanceStep() and solveStep(), and the
+  model class must provide getState() and setState(), see SIMAD.
+  Steppers with internal state, such as a multistep history or a step size
+  controller, must also provide reset(), which is invoked before each period
+  integration such that they all use the same period map.
+*/
+
+template<class Stepper, class Model>
+class SIMPeriodicShooting
+{
+public:
+  //! \brief The constructor initializes the iteration parameters.
+  //! \param s The time stepping driver
+  //! \param m The simulator holding the solution state
+  //! \param[in] T The period
+  //! \param[in] eps Relative tolerance of the periodicity residual
+  //! \param[in] nIt Maximum number of Newton iterations
+  //! \param[in] nKrylov Maximum number of GMRES iterations per Newton step
+  SIMPeriodicShooting(Stepper& s, Model& m, double T, double eps = 1.0e-6,
+                      int nIt = 10, int nKrylov = 20) :
+    stepper(s), model(m), period(T), tol(eps), maxIt(nIt), kdim(nKrylov)
+  {
+  }
+
+  //! \brief Computes the periodic state and sets it as the initial state.
+  //! \param[in] tp0 Time stepping parameters at the start of the period
+  bool solve(const TimeStep& tp0)
+  {
+    PROFILE1("SIMPeriodicShooting::solve");
+
+    Vector u, Pu;
+    model.getState(u);
+    if (!this->integrate(u,tp0))
+      return false;
+
+    bool converged = false;
+    for (int it = 1; it <= maxIt && !converged; it++) {
+      Pu = u;
+      if (!this->integrate(Pu,tp0))
+        return false;
+
+      Vector r(Pu);
+      r -= u;
+      double rnorm = r.norm2();
+      double unorm = u.norm2();
+      IFEM::cout <<"  Shooting iteration "<< it <<": periodicity residual "
+                 << rnorm <<" ("<< nPeriods <<" periods integrated)"
+                 << std::endl;
+
+      if (rnorm <= tol*(unorm > 0.0 ? unorm : 1.0)) {
+        u = Pu;
+        converged = true;
+      }
+      else {
+        Vector du(r.size());
+        ADGMRES gmres(eta,kdim,kdim);
+        ADGMRES::Operator J = [this,&u,&Pu,&tp0](const Vector& v, Vector& w)
+        {
+          return this->applyJacobian(u,Pu,v,w,tp0);
+        };
+        if (!gmres.solve(J,nullptr,r,du))
+          return false;
+        if (Model::msgLevel > 0)
+          IFEM::cout <<"  GMRES: "<< gmres.getIterations()
+                     <<" iterations, residual reduced by "
+                     << gmres.getResidual() << std::endl;
+        u += du;
+      }
+    }
+
+    if (!model.setState(u))
+      return false;
+    if (!converged)
+      std::cerr <<" *** SIMPeriodicShooting::solve: No convergence in "
+                << maxIt <<" iterations."<< std::endl;
+
+    return converged;
+  }
+
+protected:
+  //! \brief Integrates the solution over one period.
+  //! \param u The state at the start of the period, at the end on output
+  //! \param[in] tp0 Time stepping parameters at the start of the period
+  bool integrate(Vector& u, const TimeStep& tp0)
+  {
+    if (!model.setState(u))
+      return false;
+    resetStepper(stepper,0);
+
+    int msgLevel = Model::msgLevel;
+    Model::msgLevel = -1;
+    TimeStep tp(tp0);
+    const double tEnd = tp0.time.t + period;
+    bool ok = true;
+    while (ok && tp.time.t + 0.5*tp.time.dt < tEnd)
+      ok = tp.increment() && stepper.advanceStep(tp) && stepper.solveStep(tp);
+    Model::msgLevel = msgLevel;
+
+    ++nPeriods;
+    model.getState(u);
+    return ok;
+  }
+
+  //! \brief Resets the internal state of a stepper providing reset().
+  template<class S>
+  static auto resetStepper(S& s, int) -> decltype(s.reset(),void())
+  {
+    s.reset();
+  }
+  //! \brief Overload for steppers without internal state.
+  template<class S>
+  static void resetStepper(S&, long) {}
+
+  //! \brief Applies the Jacobian of the periodicity residual.
+  //! \details The advection-diffusion problem is linear in the temperature,
+  //! so the period map is affine and the difference quotient is exact for
+  //! any perturbation size. The perturbation is scaled to the solution to
+  //! keep the round-off error low.
+  //! \param[in] u The state at the start of the period
+  //! \param[in] Pu The period map of \a u
+  //! \param[in] v The vector to apply the Jacobian to
+  //! \param[out] w The product \f$(I - P'(u))v\f$
+  //! \param[in] tp0 Time stepping parameters at the start of the period
+  bool applyJacobian(const Vector& u, const Vector& Pu, const Vector& v,
+                     Vector& w, const TimeStep& tp0)
+  {
+    double vnorm = v.norm2();
+    if (vnorm <= 0.0) {
+      w.resize(v.size(),true);
+      return true;
+    }
+    double unorm = u.norm2();
+    double eps = (unorm > 1.0 ? unorm : 1.0)/vnorm;
+    w = u;
+    w.add(v,eps);
+    if (!this->integrate(w,tp0))
+      return false;
+
+    w -= Pu;
+    w *= -1.0/eps;
+    w += v;
+    return true;
+  }
+
+  Stepper& stepper; //!< Reference to the time stepping driver
+  Model&   model;   //!< Reference to the simulator
+
+  double period; //!< The period
+  double tol;    //!< Relative tolerance of the periodicity residual
+  int    maxIt;  //!< Maximum number of Newton iterations
+  int    kdim;   //!< Maximum number of GMRES iterations
+  double eta = 1.0e-3; //!< Relative tolerance of the GMRES iterations
+  int    nPeriods = 0; //!< Number of period integrations
+};
+
+#endif